@@ -0,0 +1,302 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include <boost/format.hpp>
+
+// Allocation counting.
+// ----------------------------------------------------------------------------
+// Replacing the global allocation functions counts every heap allocation of
+// the program, including those of the library. The array and nothrow forms
+// default to these. The counter is constant-initialized.
+
+static std::atomic<uint64_t> allocations(0);
+
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    const auto pointer = std::malloc(size == 0 ? 1 : size);
+
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+namespace benchmark {
+
+using boost::format;
+
+static constexpr size_t max_iterations = 1000000000;
+static constexpr double default_min_time = 0.5;
+static constexpr size_t default_repetitions = 3;
+
+registration* registration::first_ = nullptr;
+
+uint64_t allocation_count()
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+// state
+// ----------------------------------------------------------------------------
+
+state::state(size_t iterations)
+  : iterations_(iterations), remaining_(iterations), running_(false),
+    bytes_(0), items_(0), allocations_(0), allocations_start_(0),
+    elapsed_(clock::duration::zero())
+{
+}
+
+bool state::keep_running()
+{
+    if (!running_ && remaining_ == iterations_)
+        resume();
+
+    if (remaining_ == 0)
+    {
+        pause();
+        return false;
+    }
+
+    --remaining_;
+    return true;
+}
+
+void state::pause()
+{
+    if (!running_)
+        return;
+
+    elapsed_ += clock::now() - start_;
+    allocations_ += allocation_count() - allocations_start_;
+    running_ = false;
+}
+
+void state::resume()
+{
+    if (running_)
+        return;
+
+    running_ = true;
+    allocations_start_ = allocation_count();
+    start_ = clock::now();
+}
+
+void state::set_bytes(uint64_t bytes)
+{
+    bytes_ = bytes;
+}
+
+void state::set_items(uint64_t items)
+{
+    items_ = items;
+}
+
+size_t state::iterations() const
+{
+    return iterations_;
+}
+
+uint64_t state::bytes() const
+{
+    return bytes_;
+}
+
+uint64_t state::items() const
+{
+    return items_;
+}
+
+uint64_t state::allocations() const
+{
+    return allocations_;
+}
+
+state::clock::duration state::elapsed() const
+{
+    return elapsed_;
+}
+
+// registration
+// ----------------------------------------------------------------------------
+
+registration::registration(const char* name, function benchmark)
+  : name_(name), benchmark_(benchmark), next_(first_)
+{
+    first_ = this;
+}
+
+// run
+// ----------------------------------------------------------------------------
+
+struct result
+{
+    size_t iterations;
+    double seconds;
+    uint64_t bytes;
+    uint64_t items;
+    uint64_t allocations;
+};
+
+static double to_seconds(const state::clock::duration& elapsed)
+{
+    return std::chrono::duration<double>(elapsed).count();
+}
+
+static result measure(const function& benchmark, size_t iterations)
+{
+    state instance(iterations);
+    benchmark(instance);
+    return{ iterations, to_seconds(instance.elapsed()), instance.bytes(),
+        instance.items(), instance.allocations() };
+}
+
+// Grow the iteration count until a run lasts at least the minimum time.
+static result calibrate(const function& benchmark, double min_time)
+{
+    size_t iterations = 1;
+
+    while (true)
+    {
+        const auto trial = measure(benchmark, iterations);
+
+        if (trial.seconds >= min_time || iterations >= max_iterations)
+            return trial;
+
+        const auto scale = trial.seconds <= 0.0 ? 10.0 :
+            std::min(10.0, 1.4 * min_time / trial.seconds);
+
+        iterations = std::min(max_iterations, std::max(iterations + 1,
+            static_cast<size_t>(iterations * scale)));
+    }
+}
+
+static std::string option(const std::string& argument,
+    const std::string& name)
+{
+    const auto prefix = "--" + name + "=";
+    return argument.compare(0, prefix.size(), prefix) == 0 ?
+        argument.substr(prefix.size()) : std::string();
+}
+
+static void report(const char* name, const result& median)
+{
+    const auto nanoseconds = 1e9 * median.seconds / median.iterations;
+    const auto per_second = median.iterations / median.seconds;
+    const auto allocations = static_cast<double>(median.allocations) /
+        median.iterations;
+
+    std::cout << format("%-52s %12u %14.1f ns %10.1f") % name %
+        median.iterations % nanoseconds % allocations;
+
+    if (median.bytes != 0)
+        std::cout << format(" %10.1f MB/s") % (median.bytes * per_second / 1e6);
+
+    if (median.items != 0)
+        std::cout << format(" %12.0f items/s") % (median.items * per_second);
+
+    std::cout << std::endl;
+}
+
+int run(int argc, char* argv[])
+{
+    std::string filter;
+    auto min_time = default_min_time;
+    auto repetitions = default_repetitions;
+    auto list = false;
+
+    for (auto index = 1; index < argc; ++index)
+    {
+        const std::string argument(argv[index]);
+
+        if (argument == "--list")
+            list = true;
+        else if (!option(argument, "filter").empty())
+            filter = option(argument, "filter");
+        else if (!option(argument, "min_time").empty())
+            min_time = std::atof(option(argument, "min_time").c_str());
+        else if (!option(argument, "repetitions").empty())
+            repetitions = static_cast<size_t>(std::max(1, std::atoi(
+                option(argument, "repetitions").c_str())));
+        else
+        {
+            std::cerr << "Unknown option: " << argument << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Registration prepends, so reverse to run in declaration order.
+    std::vector<const registration*> benchmarks;
+    for (auto it = registration::first_; it != nullptr; it = it->next_)
+        if (std::string(it->name_).find(filter) != std::string::npos)
+            benchmarks.push_back(it);
+
+    std::reverse(benchmarks.begin(), benchmarks.end());
+
+    if (list)
+    {
+        for (const auto benchmark: benchmarks)
+            std::cout << benchmark->name_ << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+    std::cout << format("%-52s %12s %17s %10s") % "benchmark" % "iterations" %
+        "time/op" % "allocs/op" << std::endl;
+
+    for (const auto benchmark: benchmarks)
+    {
+        const auto first = calibrate(benchmark->benchmark_, min_time);
+        std::vector<result> results{ first };
+
+        for (size_t count = 1; count < repetitions; ++count)
+            results.push_back(measure(benchmark->benchmark_,
+                first.iterations));
+
+        const auto middle = results.begin() + results.size() / 2;
+        std::nth_element(results.begin(), middle, results.end(),
+            [](const result& left, const result& right)
+            {
+                return left.seconds < right.seconds;
+            });
+
+        report(benchmark->name_, *middle);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+} // namespace benchmark
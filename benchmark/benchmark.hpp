@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_BENCHMARK_HPP
+#define LIBBITCOIN_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace benchmark {
+
+/**
+ * The iteration state of one benchmark run, in the manner of
+ * google benchmark: while (state.keep_running()) { ... }
+ */
+class state
+{
+public:
+    typedef std::chrono::steady_clock clock;
+
+    state(size_t iterations);
+
+    /// True while iterations remain, the clock starts on the first call.
+    bool keep_running();
+
+    /// Exclude setup within the loop from the measurement (and count).
+    void pause();
+    void resume();
+
+    /// Per iteration throughput, reported as MB/s and items/s.
+    void set_bytes(uint64_t bytes);
+    void set_items(uint64_t items);
+
+    size_t iterations() const;
+    uint64_t bytes() const;
+    uint64_t items() const;
+    uint64_t allocations() const;
+    clock::duration elapsed() const;
+
+private:
+    const size_t iterations_;
+    size_t remaining_;
+    bool running_;
+    uint64_t bytes_;
+    uint64_t items_;
+    uint64_t allocations_;
+    uint64_t allocations_start_;
+    clock::time_point start_;
+    clock::duration elapsed_;
+};
+
+typedef std::function<void(state&)> function;
+
+/**
+ * Registers a benchmark at static initialization, see BENCHMARK.
+ */
+class registration
+{
+public:
+    registration(const char* name, function benchmark);
+
+private:
+    friend int run(int argc, char* argv[]);
+
+    static registration* first_;
+
+    const char* name_;
+    const function benchmark_;
+    registration* next_;
+};
+
+/// Prevent the optimizer from eliding the computation of a value.
+template <typename Type>
+void keep(const Type& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/// The number of heap allocations made by the process, see benchmark.cpp.
+uint64_t allocation_count();
+
+/**
+ * Run the registered benchmarks, returns the process exit code.
+ * Options: --filter=<substring> --min_time=<seconds> --repetitions=<count>
+ * and --list. Each result is the median of the repetitions, reported with
+ * its heap allocations per iteration.
+ */
+int run(int argc, char* argv[]);
+
+} // namespace benchmark
+
+#define BENCHMARK(name) \
+    static void name(benchmark::state& state); \
+    static const benchmark::registration name##_registration(#name, name); \
+    static void name(benchmark::state& state)
+
+#endif
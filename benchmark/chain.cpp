@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <stdexcept>
+#include <bitcoin/bitcoin.hpp>
+#include "benchmark.hpp"
+#include "fixtures.hpp"
+
+using namespace bc;
+using namespace bc::chain;
+
+BENCHMARK(block__from_data__genesis)
+{
+    const auto data = genesis_block().to_data();
+    state.set_bytes(data.size());
+    block instance;
+
+    while (state.keep_running())
+        benchmark::keep(instance.from_data(data));
+}
+
+BENCHMARK(block__from_data__mainnet_like)
+{
+    const auto data = mainnet_like_block().to_data();
+    state.set_bytes(data.size());
+    block instance;
+
+    while (state.keep_running())
+        benchmark::keep(instance.from_data(data));
+}
+
+BENCHMARK(transaction__from_data)
+{
+    const auto data = mainnet_like_block(1).transactions.front().to_data();
+    state.set_bytes(data.size());
+    transaction instance;
+
+    while (state.keep_running())
+        benchmark::keep(instance.from_data(data));
+}
+
+BENCHMARK(transaction__to_data)
+{
+    const auto instance = mainnet_like_block(1).transactions.front();
+    state.set_bytes(instance.serialized_size());
+
+    while (state.keep_running())
+        benchmark::keep(instance.to_data());
+}
+
+BENCHMARK(transaction__hash)
+{
+    const auto instance = mainnet_like_block(1).transactions.front();
+
+    while (state.keep_running())
+        benchmark::keep(instance.hash());
+}
+
+BENCHMARK(block__generate_merkle_root__mainnet_like)
+{
+    const auto instance = mainnet_like_block();
+    state.set_items(instance.transactions.size());
+
+    while (state.keep_running())
+        benchmark::keep(block::generate_merkle_root(instance.transactions));
+}
+
+BENCHMARK(script__verify__pay_key_hash)
+{
+    script prevout_script;
+    const auto spend = signed_spend(prevout_script);
+    const auto& input_script = spend.inputs.front().script;
+
+    if (!script::verify(input_script, prevout_script, spend, 0))
+        throw std::logic_error("invalid script fixture");
+
+    while (state.keep_running())
+        benchmark::keep(script::verify(input_script, prevout_script, spend,
+            0));
+}
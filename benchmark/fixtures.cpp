@@ -0,0 +1,178 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "fixtures.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+
+static const auto genesis_block_mainnet =
+    "01000000"
+    "0000000000000000000000000000000000000000000000000000000000000000"
+    "3ba3edfd7a7b12b27ac72c3e67768f617fc81bc3888a51323a9fb8aa4b1e5e4a"
+    "29ab5f49"
+    "ffff001d"
+    "1dac2b7c"
+    "01"
+    "01000000"
+    "01"
+    "0000000000000000000000000000000000000000000000000000000000000000ffffffff"
+    "4d"
+    "04ffff001d0104455468652054696d65732030332f4a616e2f32303039204368616e63656c6c6f72206f6e206272696e6b206f66207365636f6e64206261696c6f757420666f722062616e6b73"
+    "ffffffff"
+    "01"
+    "00f2052a01000000"
+    "43"
+    "4104678afdb0fe5548271967f1a67130b7105cd6a828e03909a67962e0ea1f61deb649f6bc3f4cef38c4f35504e51ec112de5c384df7ba0b8d578a4c702b6bf11d5fac"
+    "00000000";
+
+static const auto genesis_hash = hash_literal(
+    "000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+
+// Fixed seeds for splitmix64, the fixtures do not use the random device.
+static void fill(uint8_t* data, size_t size, uint64_t& seed)
+{
+    for (size_t index = 0; index < size; ++index)
+        data[index] = static_cast<uint8_t>(splitmix64(seed));
+}
+
+block genesis_block()
+{
+    data_chunk data;
+    decode_base16(data, genesis_block_mainnet);
+    const auto genesis = block::factory_from_data(data);
+
+    if (genesis.header.hash() != genesis_hash)
+        throw std::logic_error("invalid genesis block fixture");
+
+    return genesis;
+}
+
+block mainnet_like_block(size_t transactions)
+{
+    uint64_t seed = 42;
+    block out;
+    out.header.version = 3;
+    out.header.timestamp = 1449000000;
+    out.header.bits = 0x181b8330;
+    out.header.nonce = 0;
+    fill(out.header.previous_block_hash.data(), hash_size, seed);
+
+    for (size_t tx = 0; tx < transactions; ++tx)
+    {
+        transaction spend;
+        spend.version = 1;
+        spend.locktime = 0;
+
+        for (size_t index = 0; index < 2; ++index)
+        {
+            // Endorsement (72 bytes) and compressed point (33 bytes).
+            data_chunk endorsement(72);
+            data_chunk point(ec_compressed_size);
+            fill(endorsement.data(), endorsement.size(), seed);
+            fill(point.data(), point.size(), seed);
+            point[0] = 0x02;
+
+            input input;
+            fill(input.previous_output.hash.data(), hash_size, seed);
+            input.previous_output.index = splitmix64(seed) % 4;
+            input.sequence = max_input_sequence;
+            input.script.operations =
+            {
+                operation{ opcode::special, endorsement },
+                operation{ opcode::special, point }
+            };
+
+            spend.inputs.push_back(input);
+        }
+
+        for (size_t index = 0; index < 2; ++index)
+        {
+            short_hash hash;
+            fill(hash.data(), hash.size(), seed);
+
+            output output;
+            output.value = splitmix64(seed) % coin_price(100);
+            output.script.operations =
+                operation::to_pay_key_hash_pattern(hash);
+
+            spend.outputs.push_back(output);
+        }
+
+        out.transactions.push_back(spend);
+    }
+
+    out.header.merkle = block::generate_merkle_root(out.transactions);
+    return out;
+}
+
+transaction signed_spend(script& prevout_script)
+{
+    static const ec_secret secret = hash_literal(
+        "8010b1bb119ad37d4b65a1022a314897b1b3614b345974332cb1b9582cf03536");
+
+    ec_compressed point;
+    if (!secret_to_public(point, secret))
+        throw std::logic_error("invalid secret fixture");
+
+    prevout_script.operations = operation::to_pay_key_hash_pattern(
+        bitcoin_short_hash(point));
+
+    uint64_t seed = 7;
+    transaction spend;
+    spend.version = 1;
+    spend.locktime = 0;
+
+    input input;
+    fill(input.previous_output.hash.data(), hash_size, seed);
+    input.previous_output.index = 0;
+    input.sequence = max_input_sequence;
+    spend.inputs.push_back(input);
+
+    output output;
+    output.value = 100000;
+    output.script = prevout_script;
+    spend.outputs.push_back(output);
+
+    endorsement signature;
+    if (!script::create_signature(signature, secret, prevout_script, spend,
+        0, signature_hash_algorithm::all))
+        throw std::logic_error("signature fixture failed");
+
+    spend.inputs.front().script.operations =
+    {
+        operation{ opcode::special, signature },
+        operation{ opcode::special, to_chunk(point) }
+    };
+
+    return spend;
+}
+
+data_chunk fixed_data(size_t size)
+{
+    uint64_t seed = size;
+    data_chunk out(size);
+    fill(out.data(), out.size(), seed);
+    return out;
+}
@@ -0,0 +1,41 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_BENCHMARK_FIXTURES_HPP
+#define LIBBITCOIN_BENCHMARK_FIXTURES_HPP
+
+#include <cstddef>
+#include <bitcoin/bitcoin.hpp>
+
+// Fixtures are deterministic so that results are comparable across builds.
+
+/// The mainnet genesis block.
+bc::chain::block genesis_block();
+
+/// A block of pay-key-hash transactions shaped like recent mainnet blocks
+/// (two inputs and two outputs each), with fixed pseudo-random content.
+bc::chain::block mainnet_like_block(size_t transactions=1500);
+
+/// A transaction whose first input validly spends the given output script.
+bc::chain::transaction signed_spend(bc::chain::script& prevout_script);
+
+/// A fixed pseudo-random buffer of the given size.
+bc::data_chunk fixed_data(size_t size);
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <sstream>
+#include <string>
+#include <bitcoin/bitcoin.hpp>
+#include "benchmark.hpp"
+#include "fixtures.hpp"
+
+using namespace bc;
+
+BENCHMARK(encode_base16__1024)
+{
+    const auto data = fixed_data(1024);
+    state.set_bytes(data.size());
+
+    while (state.keep_running())
+        benchmark::keep(encode_base16(data));
+}
+
+BENCHMARK(decode_base16__1024)
+{
+    const auto text = encode_base16(fixed_data(1024));
+    state.set_bytes(text.size());
+    data_chunk out;
+
+    while (state.keep_running())
+        benchmark::keep(decode_base16(out, text));
+}
+
+BENCHMARK(encode_base58__address)
+{
+    const auto data = fixed_data(25);
+
+    while (state.keep_running())
+        benchmark::keep(encode_base58(data));
+}
+
+BENCHMARK(decode_base58__address)
+{
+    const auto text = encode_base58(fixed_data(25));
+    data_chunk out;
+
+    while (state.keep_running())
+        benchmark::keep(decode_base58(out, text));
+}
+
+BENCHMARK(encode_base58_check__address)
+{
+    const auto data = fixed_data(21);
+
+    while (state.keep_running())
+        benchmark::keep(encode_base58_check(data));
+}
+
+BENCHMARK(encode_base64__4096)
+{
+    const auto data = fixed_data(4096);
+    state.set_bytes(data.size());
+
+    while (state.keep_running())
+        benchmark::keep(encode_base64(data));
+}
+
+BENCHMARK(decode_base64__4096)
+{
+    const auto text = encode_base64(fixed_data(4096));
+    state.set_bytes(text.size());
+    data_chunk out;
+
+    while (state.keep_running())
+        benchmark::keep(decode_base64(out, text));
+}
+
+BENCHMARK(encode_base64__stream__1048576)
+{
+    const auto data = fixed_data(1048576);
+    const std::string buffer(data.begin(), data.end());
+    state.set_bytes(data.size());
+
+    while (state.keep_running())
+    {
+        std::istringstream in(buffer);
+        std::ostringstream out;
+        benchmark::keep(encode_base64(out, in));
+    }
+}
+
+BENCHMARK(encode_base85__4096)
+{
+    const auto data = fixed_data(4096);
+    state.set_bytes(data.size());
+    std::string out;
+
+    while (state.keep_running())
+        benchmark::keep(encode_base85(out, data));
+}
+
+BENCHMARK(decode_base85__4096)
+{
+    std::string text;
+    encode_base85(text, fixed_data(4096));
+    state.set_bytes(text.size());
+    data_chunk out;
+
+    while (state.keep_running())
+        benchmark::keep(decode_base85(out, text));
+}
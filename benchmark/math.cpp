@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include "benchmark.hpp"
+#include "fixtures.hpp"
+
+using namespace bc;
+
+BENCHMARK(sha256_hash__1024)
+{
+    const auto data = fixed_data(1024);
+    state.set_bytes(data.size());
+
+    while (state.keep_running())
+        benchmark::keep(sha256_hash(data));
+}
+
+BENCHMARK(bitcoin_hash__header)
+{
+    const auto data = genesis_block().header.to_data(false);
+    state.set_bytes(data.size());
+
+    while (state.keep_running())
+        benchmark::keep(bitcoin_hash(data));
+}
+
+BENCHMARK(bitcoin_short_hash__compressed_point)
+{
+    const auto data = fixed_data(ec_compressed_size);
+
+    while (state.keep_running())
+        benchmark::keep(bitcoin_short_hash(data));
+}
+
+BENCHMARK(hash_number__set_compact)
+{
+    hash_number target;
+    uint32_t bits = 0x1b0404cb;
+
+    while (state.keep_running())
+    {
+        benchmark::keep(target.set_compact(bits));
+        bits ^= 0x00000100;
+    }
+}
+
+BENCHMARK(hash_number__compact)
+{
+    hash_number target;
+    target.set_compact(0x1b0404cb);
+
+    while (state.keep_running())
+        benchmark::keep(target.compact());
+}
+
+// Chain work summation as in header sync: work = ~target / (target + 1) + 1.
+BENCHMARK(hash_number__work__1000_headers)
+{
+    static const size_t headers = 1000;
+    const hash_number one(1);
+    state.set_items(headers);
+
+    while (state.keep_running())
+    {
+        hash_number total;
+
+        for (size_t index = 0; index < headers; ++index)
+        {
+            hash_number target;
+            target.set_compact(0x1b0404cb - static_cast<uint32_t>(index));
+            total += (~target / (target + one)) + one;
+        }
+
+        benchmark::keep(total);
+    }
+}
+
+// Typical txid map of ten thousand entries, hashing dominates lookup.
+template <typename Hasher>
+static void txid_lookup(benchmark::state& state, const Hasher& hasher)
+{
+    static const size_t entries = 10000;
+    const auto data = fixed_data(entries * hash_size);
+    std::vector<hash_digest> keys(entries);
+    std::unordered_map<hash_digest, size_t, Hasher> map(entries, hasher);
+
+    for (size_t index = 0; index < entries; ++index)
+    {
+        std::copy(data.begin() + index * hash_size,
+            data.begin() + (index + 1) * hash_size, keys[index].begin());
+        map.emplace(keys[index], index);
+    }
+
+    size_t index = 0;
+    while (state.keep_running())
+    {
+        benchmark::keep(map.find(keys[index])->second);
+        index = (index + 1) % entries;
+    }
+}
+
+BENCHMARK(unordered_map__find__std_hash)
+{
+    txid_lookup(state, std::hash<hash_digest>());
+}
+
+BENCHMARK(unordered_map__find__salted_hash)
+{
+    txid_lookup(state, salted_hash(42));
+}
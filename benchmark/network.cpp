@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <boost/iostreams/stream.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include "benchmark.hpp"
+#include "fixtures.hpp"
+
+using namespace bc;
+using namespace bc::message;
+using namespace bc::network;
+
+typedef byte_source<data_chunk> payload_source;
+typedef boost::iostreams::stream<payload_source> payload_stream;
+
+// Parse and relay (without subscribers) as the channel does per message.
+static void load(benchmark::state& state, message_type type,
+    const data_chunk& payload)
+{
+    threadpool pool(1);
+    message_subscriber subscriber(pool);
+    state.set_bytes(payload.size());
+
+    while (state.keep_running())
+    {
+        payload_source source(payload);
+        payload_stream istream(source);
+        benchmark::keep(subscriber.load(type, istream));
+    }
+
+    pool.shutdown();
+    pool.join();
+}
+
+BENCHMARK(message_subscriber__load__block)
+{
+    load(state, message_type::block, mainnet_like_block().to_data());
+}
+
+BENCHMARK(message_subscriber__load__transaction)
+{
+    load(state, message_type::transaction,
+        mainnet_like_block(1).transactions.front().to_data());
+}
+
+BENCHMARK(message_subscriber__load__ping)
+{
+    load(state, message_type::ping, ping(42).to_data());
+}
@@ -0,0 +1,485 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/algorithm/string.hpp>
+#include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include "fixtures.hpp"
+
+#ifdef __linux__
+    #include <unistd.h>
+#endif
+
+// An end to end benchmark of a p2p node flooded by synthetic loopback peers.
+// Each peer completes the version handshake and then sends its share of
+// messages, drawn from a fixed mix by a seeded generator so that every run
+// sends the same sequence. A ping from the mix is sent only after the pong
+// of the previous ping, its round trip measures the latency of the node in
+// handling the messages queued before it. A final ping confirms that the
+// node has handled every message before the clock stops.
+
+using namespace bc;
+using namespace bc::message;
+using namespace bc::network;
+using boost::asio::ip::tcp;
+using boost::format;
+
+typedef std::chrono::steady_clock clock_type;
+
+enum mix_index { mix_inv, mix_tx, mix_addr, mix_block, mix_ping, mix_size };
+
+static const char* mix_names[mix_size] = { "inv", "tx", "addr", "block",
+    "ping" };
+
+struct options
+{
+    size_t peers;
+    size_t messages;
+    size_t threads;
+    uint16_t port;
+    size_t block_transactions;
+    size_t weights[mix_size];
+};
+
+// Serialized messages, shared by all peers.
+struct payloads
+{
+    data_chunk messages[mix_size];
+};
+
+struct peer_result
+{
+    size_t messages;
+    std::vector<double> latencies;
+};
+
+// The resident memory of this process (which includes the peers, though
+// their buffers are small), or zero if unavailable.
+static size_t resident_bytes()
+{
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    size_t total = 0;
+    size_t resident = 0;
+    if (statm >> total >> resident)
+        return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    return 0;
+}
+
+class peer
+{
+public:
+    peer(const options& options, const payloads& payloads, uint32_t magic,
+        size_t index)
+      : options_(options), payloads_(payloads), magic_(magic),
+        seed_(index + 1), socket_(service_)
+    {
+    }
+
+    // The node may not yet be listening, so retry for a few seconds.
+    void connect()
+    {
+        const tcp::endpoint node(boost::asio::ip::address_v4::loopback(),
+            options_.port);
+
+        for (auto attempt = 0; attempt < 100; ++attempt)
+        {
+            boost::system::error_code ec;
+            socket_.connect(node, ec);
+
+            // Measure the node, not the peer's Nagle delay.
+            if (!ec)
+            {
+                socket_.set_option(tcp::no_delay(true));
+                return;
+            }
+
+            socket_.close();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+
+        throw std::runtime_error("unable to connect to the node");
+    }
+
+    // Complete when the node has pinged, as it does once the handshake
+    // is complete and its ping protocol is attached.
+    void handshake()
+    {
+        auto self = version_factory();
+        write(serialize(self, magic_));
+        write(serialize(verack(), magic_));
+
+        auto version_received = false;
+        auto verack_received = false;
+        auto ping_received = false;
+
+        while (!version_received || !verack_received || !ping_received)
+        {
+            const auto head = read_heading();
+            const auto payload = read_payload(head);
+
+            if (head.command == version::command)
+                version_received = true;
+            else if (head.command == verack::command)
+                verack_received = true;
+            else if (head.command == ping::command)
+            {
+                answer(payload);
+                ping_received = true;
+            }
+        }
+    }
+
+    peer_result flood()
+    {
+        peer_result result{ 0, {} };
+        size_t total_weight = 0;
+        for (const auto weight: options_.weights)
+            total_weight += weight;
+
+        for (size_t count = 0; count < options_.messages; ++count)
+        {
+            auto pick = splitmix64(seed_) % total_weight;
+            size_t index = 0;
+            while (pick >= options_.weights[index])
+                pick -= options_.weights[index++];
+
+            if (index == mix_ping)
+                result.latencies.push_back(round_trip());
+            else
+                write(payloads_.messages[index]);
+
+            ++result.messages;
+        }
+
+        // Drain, this also ensures the node handled every message.
+        round_trip();
+        return result;
+    }
+
+private:
+    version version_factory()
+    {
+        version self;
+        self.value = bc::protocol_version;
+        self.services = services::node_network;
+        self.timestamp = static_cast<uint64_t>(std::time(nullptr));
+        self.address_me = unspecified_network_address;
+        self.address_you = unspecified_network_address;
+        self.nonce = splitmix64(seed_) | 1;
+        self.user_agent = "/libbitcoin:benchmark/";
+        self.start_height = 0;
+        self.relay = true;
+        return self;
+    }
+
+    // Returns the latency in microseconds.
+    double round_trip()
+    {
+        const auto nonce = splitmix64(seed_);
+        const auto start = clock_type::now();
+        write(serialize(ping(nonce), magic_));
+
+        while (true)
+        {
+            const auto head = read_heading();
+            const auto payload = read_payload(head);
+
+            if (head.command == ping::command)
+                answer(payload);
+            else if (head.command == pong::command &&
+                pong::factory_from_data(payload).nonce == nonce)
+                break;
+        }
+
+        const auto elapsed = clock_type::now() - start;
+        return std::chrono::duration<double, std::micro>(elapsed).count();
+    }
+
+    void answer(const data_chunk& payload)
+    {
+        const auto request = ping::factory_from_data(payload);
+        write(serialize(pong(request.nonce), magic_));
+    }
+
+    void write(const data_chunk& message)
+    {
+        boost::asio::write(socket_, boost::asio::buffer(message));
+    }
+
+    heading read_heading()
+    {
+        heading::buffer buffer;
+        boost::asio::read(socket_, boost::asio::buffer(buffer));
+        const auto head = heading::factory_from_data(
+            data_chunk(buffer.begin(), buffer.end()));
+
+        if (head.magic != magic_)
+            throw std::runtime_error("invalid heading from the node");
+
+        return head;
+    }
+
+    data_chunk read_payload(const heading& head)
+    {
+        data_chunk payload(head.payload_size);
+        boost::asio::read(socket_, boost::asio::buffer(payload));
+        return payload;
+    }
+
+    const options& options_;
+    const payloads& payloads_;
+    const uint32_t magic_;
+    uint64_t seed_;
+    boost::asio::io_service service_;
+    tcp::socket socket_;
+};
+
+static payloads make_payloads(const options& options, uint32_t magic)
+{
+    uint64_t seed = 0;
+    const auto block = mainnet_like_block(options.block_transactions);
+
+    inventory inventory;
+    for (size_t index = 0; index < 10; ++index)
+    {
+        hash_digest hash;
+        for (auto& byte: hash)
+            byte = static_cast<uint8_t>(splitmix64(seed));
+
+        inventory.inventories.push_back(
+            { inventory_type_id::transaction, hash });
+    }
+
+    address addresses;
+    for (size_t index = 0; index < 10; ++index)
+    {
+        network_address address = unspecified_network_address;
+        address.timestamp = static_cast<uint32_t>(std::time(nullptr));
+        address.services = services::node_network;
+        address.ip[15] = static_cast<uint8_t>(index + 1);
+        address.port = 8333;
+        addresses.addresses.push_back(address);
+    }
+
+    payloads out;
+    out.messages[mix_inv] = serialize(inventory, magic);
+    out.messages[mix_tx] = serialize(block.transactions.front(), magic);
+    out.messages[mix_addr] = serialize(addresses, magic);
+    out.messages[mix_block] = serialize(block, magic);
+    return out;
+}
+
+static double percentile(std::vector<double>& values, double fraction)
+{
+    if (values.empty())
+        return 0.0;
+
+    const auto index = std::min(values.size() - 1,
+        static_cast<size_t>(fraction * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+static bool parse_mix(options& out, const std::string& text)
+{
+    std::fill(std::begin(out.weights), std::end(out.weights), 0);
+    std::vector<std::string> entries;
+    boost::split(entries, text, boost::is_any_of(","));
+
+    for (const auto& entry: entries)
+    {
+        const auto colon = entry.find(':');
+        if (colon == std::string::npos)
+            return false;
+
+        const auto name = entry.substr(0, colon);
+        const auto it = std::find(std::begin(mix_names), std::end(mix_names),
+            name);
+
+        if (it == std::end(mix_names))
+            return false;
+
+        out.weights[it - std::begin(mix_names)] = std::atoi(
+            entry.substr(colon + 1).c_str());
+    }
+
+    return std::any_of(std::begin(out.weights), std::end(out.weights),
+        [](size_t weight) { return weight != 0; });
+}
+
+static bool parse(options& out, int argc, char* argv[])
+{
+    out = { 8, 10000, 4, 18444, 500, { 50, 35, 5, 1, 9 } };
+
+    for (auto index = 1; index < argc; ++index)
+    {
+        const std::string argument(argv[index]);
+        const auto equals = argument.find('=');
+        if (argument.compare(0, 2, "--") != 0 || equals == std::string::npos)
+            return false;
+
+        const auto name = argument.substr(2, equals - 2);
+        const auto value = argument.substr(equals + 1);
+        const auto number = static_cast<size_t>(std::atoll(value.c_str()));
+
+        if (name == "peers")
+            out.peers = number;
+        else if (name == "messages")
+            out.messages = number;
+        else if (name == "threads")
+            out.threads = number;
+        else if (name == "port")
+            out.port = static_cast<uint16_t>(number);
+        else if (name == "block_transactions")
+            out.block_transactions = number;
+        else if (name != "mix" || !parse_mix(out, value))
+            return false;
+    }
+
+    return out.peers != 0 && out.threads != 0 && out.port != 0 &&
+        out.block_transactions != 0;
+}
+
+static void usage()
+{
+    std::cerr <<
+        "Usage: libbitcoin_p2p_benchmark [--peers=8] [--messages=10000]\n"
+        "    [--threads=4] [--port=18444] [--block_transactions=500]\n"
+        "    [--mix=inv:50,tx:35,addr:5,block:1,ping:9]\n"
+        "Messages are per peer, the mix is of relative weights." << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    options options;
+    if (!parse(options, argc, argv))
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    const auto hosts = boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path("libbitcoin-%%%%-%%%%.hosts");
+
+    settings configuration = p2p::mainnet;
+    configuration.threads = static_cast<uint32_t>(options.threads);
+    configuration.inbound_port = options.port;
+    configuration.inbound_connection_limit =
+        static_cast<uint32_t>(options.peers);
+    configuration.outbound_connections = 0;
+    configuration.host_pool_capacity = 0;
+    configuration.hosts_file = hosts;
+    configuration.seeds.clear();
+
+    p2p node(configuration);
+    std::promise<code> started;
+    node.start([&started](const code& ec) { started.set_value(ec); });
+    const auto ec = started.get_future().get();
+
+    if (ec)
+    {
+        std::cerr << "Node failed to start: " << ec.message() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const auto data = make_payloads(options, configuration.identifier);
+    std::vector<std::unique_ptr<peer>> peers;
+
+    try
+    {
+        const auto memory_before = resident_bytes();
+
+        for (size_t index = 0; index < options.peers; ++index)
+        {
+            peers.emplace_back(new peer(options, data,
+                configuration.identifier, index));
+            peers.back()->connect();
+            peers.back()->handshake();
+        }
+
+        const auto memory_after = resident_bytes();
+        std::vector<std::future<peer_result>> results;
+        const auto start = clock_type::now();
+
+        for (const auto& instance: peers)
+        {
+            const auto flooder = instance.get();
+            results.push_back(std::async(std::launch::async,
+                [flooder]() { return flooder->flood(); }));
+        }
+
+        size_t messages = 0;
+        std::vector<double> latencies;
+        for (auto& result: results)
+        {
+            const auto value = result.get();
+            messages += value.messages;
+            latencies.insert(latencies.end(), value.latencies.begin(),
+                value.latencies.end());
+        }
+
+        const auto seconds = std::chrono::duration<double>(
+            clock_type::now() - start).count();
+        const auto memory = memory_after > memory_before ?
+            (memory_after - memory_before) / options.peers : 0;
+
+        bc::cout << format("peers %u, messages %u, threads %u\n") %
+            options.peers % messages % options.threads;
+        bc::cout << format("throughput %.0f messages/s\n") %
+            (messages / seconds);
+        bc::cout << format("latency p50 %.1f us, p99 %.1f us (%u samples)\n")
+            % percentile(latencies, 0.5) % percentile(latencies, 0.99) %
+            latencies.size();
+
+        if (memory_after == 0)
+            bc::cout << "memory per channel n/a" << std::endl;
+        else
+            bc::cout << format("memory per channel %u bytes\n") % memory;
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << "Benchmark failed: " << exception.what() << std::endl;
+        node.close();
+        boost::filesystem::remove(hosts);
+        return EXIT_FAILURE;
+    }
+
+    peers.clear();
+    node.close();
+    boost::filesystem::remove(hosts);
+    return EXIT_SUCCESS;
+}
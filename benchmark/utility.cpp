@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <bitcoin/bitcoin.hpp>
+#include "benchmark.hpp"
+#include "fixtures.hpp"
+
+using namespace bc;
+
+static const binary_type::size_type bits = 256;
+
+BENCHMARK(binary_type__shift_left__256)
+{
+    const binary_type source(bits, fixed_data(bits / 8));
+
+    while (state.keep_running())
+    {
+        state.pause();
+        auto value = source;
+        state.resume();
+        value.shift_left(13);
+        benchmark::keep(value);
+    }
+}
+
+BENCHMARK(binary_type__shift_right__256)
+{
+    const binary_type source(bits, fixed_data(bits / 8));
+
+    while (state.keep_running())
+    {
+        state.pause();
+        auto value = source;
+        state.resume();
+        value.shift_right(13);
+        benchmark::keep(value);
+    }
+}
+
+BENCHMARK(binary_type__substring__256)
+{
+    const binary_type source(bits, fixed_data(bits / 8));
+    binary_type out;
+
+    while (state.keep_running())
+    {
+        source.substring(out, 13, 200);
+        benchmark::keep(out);
+    }
+}
+
+// Stealth prefix filtering, a 16 bit prefix against each script hash.
+BENCHMARK(binary_type__is_prefix_of__data)
+{
+    const auto field = fixed_data(hash_size);
+    const binary_type prefix(16, field);
+
+    while (state.keep_running())
+        benchmark::keep(prefix.is_prefix_of(field));
+}
+
+BENCHMARK(binary_type__is_prefix_of__uint32)
+{
+    const uint32_t field = 0xdeadbeef;
+    const binary_type prefix(16, to_little_endian(field));
+
+    while (state.keep_running())
+        benchmark::keep(prefix.is_prefix_of(field));
+}
+
+// A protocol handler: a bound member, a shared pointer, a placeholder and a
+// nonce, as bound for a pong.
+struct handler_target
+{
+    void handle(const code& ec, uint64_t nonce)
+    {
+        benchmark::keep(ec);
+        benchmark::keep(nonce);
+    }
+};
+
+BENCHMARK(std_function__construct_invoke__bound_shared_pointer)
+{
+    const auto target = std::make_shared<handler_target>();
+    const uint64_t nonce = 42;
+
+    while (state.keep_running())
+    {
+        const std::function<void(const code&)> handler = std::bind(
+            &handler_target::handle, target, std::placeholders::_1, nonce);
+        handler(error::success);
+    }
+}
+
+BENCHMARK(callback__construct_invoke__bound_shared_pointer)
+{
+    const auto target = std::make_shared<handler_target>();
+    const uint64_t nonce = 42;
+
+    while (state.keep_running())
+    {
+        const callback<void(const code&)> handler = std::bind(
+            &handler_target::handle, target, std::placeholders::_1, nonce);
+        handler(error::success);
+    }
+}
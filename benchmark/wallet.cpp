@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin.hpp>
+#include "benchmark.hpp"
+#include "fixtures.hpp"
+
+using namespace bc;
+using namespace bc::chain;
+using namespace bc::wallet;
+
+static output_info_list unspent_outputs(size_t count)
+{
+    const auto data = fixed_data(count * hash_size);
+    output_info_list out(count);
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        std::copy(data.begin() + index * hash_size,
+            data.begin() + (index + 1) * hash_size,
+            out[index].point.hash.begin());
+        out[index].point.index = 0;
+        out[index].value = from_little_endian_unsafe<uint32_t>(
+            data.begin() + index * hash_size);
+    }
+
+    return out;
+}
+
+BENCHMARK(select_outputs__greedy__1000)
+{
+    const auto unspent = unspent_outputs(1000);
+    const uint64_t amount = 10000000000;
+
+    while (state.keep_running())
+        benchmark::keep(select_outputs(unspent, amount).change);
+}
+
+BENCHMARK(output_index__select__greedy__1000)
+{
+    output_index index;
+    for (const auto& output: unspent_outputs(1000))
+        index.insert(output);
+
+    const uint64_t amount = 10000000000;
+
+    while (state.keep_running())
+        benchmark::keep(index.select(amount).change);
+}
+
+BENCHMARK(hd_private__derive_private)
+{
+    const hd_private root(fixed_data(32));
+    uint32_t index = 0;
+
+    while (state.keep_running())
+        benchmark::keep(root.derive_private(index++));
+}
+
+BENCHMARK(hd_private__derive_private__hardened)
+{
+    const hd_private root(fixed_data(32));
+    uint32_t index = hd_first_hardened_key;
+
+    while (state.keep_running())
+        benchmark::keep(root.derive_private(index++));
+}
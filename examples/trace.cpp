@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <boost/date_time.hpp>
+#include <boost/format.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+BC_USE_LIBBITCOIN_MAIN
+
+using namespace bc;
+using namespace bc::network;
+using boost::format;
+using boost::posix_time::from_time_t;
+using boost::posix_time::microseconds;
+using boost::posix_time::to_iso_extended_string;
+
+// Decode a binary protocol trace file to text, one event for each line.
+int bc::main(int argc, char* argv[])
+{
+    set_utf8_stdio();
+
+    if (argc != 2)
+    {
+        bc::cerr << "Usage: libbitcoin_trace <trace-file>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    trace::list records;
+    if (!trace::read(records, argv[1]))
+    {
+        bc::cerr << "Invalid trace file: " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    static const auto form = "%1% %2% %3% [%4%] (%5% bytes, %6% us)";
+    const auto epoch = from_time_t(0);
+
+    for (const auto& record: records)
+    {
+        const auto time = epoch + microseconds(record.timestamp);
+        const std::string command(record.command.begin(),
+            std::find(record.command.begin(), record.command.end(), 0x00));
+        const config::authority authority(record.ip, record.port);
+
+        bc::cout << format(form) % to_iso_extended_string(time) %
+            trace::to_text(record.event) % command % authority %
+            record.payload_size % record.duration << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -20,6 +20,8 @@
 #ifndef LIBBITCOIN_BASE16_HPP
 #define LIBBITCOIN_BASE16_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
@@ -38,12 +40,31 @@ bool is_base16(const char c);
  */
 BC_API std::string encode_base16(data_slice data);
 
+/**
+ * Convert data into a hex string, reusing the capacity of the string.
+ */
+BC_API void encode_base16(std::string& out, data_slice data);
+
+/**
+ * Convert data into hex characters in a caller-provided buffer.
+ * Exactly twice the data size is written, with no null terminator.
+ */
+BC_API void encode_base16(char* out, data_slice data);
+
 /**
  * Convert a hex string into bytes.
  * @return false if the input is malformed.
  */
 BC_API bool decode_base16(data_chunk& out, const std::string &in);
 
+/**
+ * Convert hex characters into a caller-provided buffer.
+ * @return false if the input is malformed, or not twice the output size.
+ * The output is not modified on failure.
+ */
+BC_API bool decode_base16(uint8_t* out, size_t out_size, const char* in,
+    size_t in_size);
+
 /**
  * Converts a hex string to a number of bytes.
  * @return false if the input is malformed, or the wrong length.
@@ -23,6 +23,7 @@
 #include <string>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/string.hpp>
 
 namespace libbitcoin {
 
@@ -57,6 +58,33 @@ BC_API std::string encode_base58(data_slice unencoded);
  */
 BC_API bool decode_base58(data_chunk& out, const std::string& in);
 
+/**
+ * Encode data and its four-byte checksum as base58 (base58check).
+ * @return the base58 encoded string.
+ */
+BC_API std::string encode_base58_check(data_slice unencoded);
+
+/**
+ * Attempt to decode base58check data, verifying and removing the checksum.
+ * Values of fixed size (addresses and keys) are better decoded to a
+ * byte_array, which does not allocate, and the checksum verified in place.
+ * @return false if the input is malformed or the checksum does not match.
+ */
+BC_API bool decode_base58_check(data_chunk& out, const std::string& in);
+
+/**
+ * Encode a list of data as base58check, in order.
+ * Working buffers are shared by the list.
+ */
+BC_API string_list encode_base58_check(const data_stack& unencoded);
+
+/**
+ * Attempt to decode a list of base58check data, in order.
+ * Working buffers are shared by the list.
+ * @return false if any element fails to decode, with the output unchanged.
+ */
+BC_API bool decode_base58_check(data_stack& out, const string_list& in);
+
 } // namespace libbitcoin
 
 #include <bitcoin/bitcoin/impl/formats/base58.ipp>
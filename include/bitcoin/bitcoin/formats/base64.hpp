@@ -20,6 +20,8 @@
 #ifndef LIBBITCOIN_BASE64_HPP
 #define LIBBITCOIN_BASE64_HPP
 
+#include <istream>
+#include <ostream>
 #include <string>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
@@ -38,6 +40,19 @@ BC_API std::string encode_base64(data_slice unencoded);
  */
 BC_API bool decode_base64(data_chunk& out, const std::string& in);
 
+/**
+ * Encode a stream as base64, in chunks, without buffering the whole input.
+ * @return false if either stream fails.
+ */
+BC_API bool encode_base64(std::ostream& out, std::istream& in);
+
+/**
+ * Attempt to decode a base64 stream, in chunks, without buffering the whole
+ * input. Output may have been written before a failure is detected.
+ * @return false if the input is not base64 or either stream fails.
+ */
+BC_API bool decode_base64(std::ostream& out, std::istream& in);
+
 } // namespace libbitcoin
 
 #endif
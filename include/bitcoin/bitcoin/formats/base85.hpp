@@ -20,6 +20,8 @@
 #ifndef LIBBITCOIN_BASE85_HPP
 #define LIBBITCOIN_BASE85_HPP
 
+#include <istream>
+#include <ostream>
 #include <string>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
@@ -38,6 +40,20 @@ BC_API bool encode_base85(std::string& out, data_slice in);
  */
 BC_API bool decode_base85(data_chunk& out, const std::string& in);
 
+/**
+ * Encode a stream as base85 (Z85), in chunks, without buffering the whole
+ * input. Output may have been written before a failure is detected.
+ * @return false if the input is not of base85 size (% 4) or a stream fails.
+ */
+BC_API bool encode_base85(std::ostream& out, std::istream& in);
+
+/**
+ * Attempt to decode a base85 (Z85) stream, in chunks, without buffering the
+ * whole input. Output may have been written before a failure is detected.
+ * @return false if the input is not base85 or either stream fails.
+ */
+BC_API bool decode_base85(std::ostream& out, std::istream& in);
+
 } // namespace libbitcoin
 
 #endif
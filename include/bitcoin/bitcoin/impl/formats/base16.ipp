@@ -31,15 +31,11 @@ BC_API bool decode_base16_private(uint8_t* out, size_t out_size,
 template <size_t Size>
 bool decode_base16(byte_array<Size>& out, const std::string &in)
 {
+    // The input is validated before the output is written.
     if (in.size() != 2 * Size)
         return false;
 
-    byte_array<Size> result;
-    if (!decode_base16_private(result.data(), result.size(), in.data()))
-        return false;
-
-    out = result;
-    return true;
+    return decode_base16_private(out.data(), out.size(), in.data());
 }
 
 template <size_t Size>
@@ -0,0 +1,282 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CALLBACK_IPP
+#define LIBBITCOIN_CALLBACK_IPP
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace libbitcoin {
+
+template <typename Result, typename... Args>
+const size_t callback<Result(Args...)>::capacity;
+
+template <typename Result, typename... Args>
+callback<Result(Args...)>::callback()
+  : invoke_(nullptr), manage_(nullptr)
+{
+}
+
+template <typename Result, typename... Args>
+callback<Result(Args...)>::callback(std::nullptr_t)
+  : callback()
+{
+}
+
+template <typename Result, typename... Args>
+template <typename Function, typename>
+callback<Result(Args...)>::callback(Function&& function)
+  : callback()
+{
+    typedef typename std::decay<Function>::type target;
+
+    if (is_null(function))
+        return;
+
+    construct(std::forward<Function>(function), fits<target>());
+}
+
+template <typename Result, typename... Args>
+callback<Result(Args...)>::callback(const callback& other)
+  : callback()
+{
+    if (other.manage_ == nullptr)
+        return;
+
+    other.manage_(operation::copy, &other.storage_, &storage_);
+    invoke_ = other.invoke_;
+    manage_ = other.manage_;
+}
+
+template <typename Result, typename... Args>
+callback<Result(Args...)>::callback(callback&& other) BC_NOEXCEPT
+  : callback()
+{
+    take(other);
+}
+
+template <typename Result, typename... Args>
+callback<Result(Args...)>& callback<Result(Args...)>::operator=(
+    const callback& other)
+{
+    if (this != &other)
+    {
+        callback copy(other);
+        reset();
+        take(copy);
+    }
+
+    return *this;
+}
+
+template <typename Result, typename... Args>
+callback<Result(Args...)>& callback<Result(Args...)>::operator=(
+    callback&& other) BC_NOEXCEPT
+{
+    if (this != &other)
+    {
+        reset();
+        take(other);
+    }
+
+    return *this;
+}
+
+template <typename Result, typename... Args>
+callback<Result(Args...)>::~callback()
+{
+    reset();
+}
+
+template <typename Result, typename... Args>
+callback<Result(Args...)>::operator bool() const
+{
+    return invoke_ != nullptr;
+}
+
+template <typename Result, typename... Args>
+bool callback<Result(Args...)>::is_inline() const
+{
+    return manage_ != nullptr &&
+        manage_(operation::query, &storage_, nullptr);
+}
+
+template <typename Result, typename... Args>
+Result callback<Result(Args...)>::operator()(Args... args) const
+{
+    if (invoke_ == nullptr)
+        throw std::bad_function_call();
+
+    return invoke_(&storage_, std::forward<Args>(args)...);
+}
+
+template <typename Result, typename... Args>
+template <typename Function>
+bool callback<Result(Args...)>::is_null(const Function&)
+{
+    return false;
+}
+
+template <typename Result, typename... Args>
+template <typename Target>
+bool callback<Result(Args...)>::is_null(Target* function)
+{
+    return function == nullptr;
+}
+
+template <typename Result, typename... Args>
+template <typename Signature>
+bool callback<Result(Args...)>::is_null(
+    const std::function<Signature>& function)
+{
+    return !function;
+}
+
+template <typename Result, typename... Args>
+template <typename Signature>
+bool callback<Result(Args...)>::is_null(const callback<Signature>& function)
+{
+    return !function;
+}
+
+// The target is constructed in place.
+template <typename Result, typename... Args>
+template <typename Function>
+void callback<Result(Args...)>::construct(Function&& function,
+    std::true_type)
+{
+    typedef typename std::decay<Function>::type target;
+    new (&storage_) target(std::forward<Function>(function));
+    invoke_ = &callback::invoke_inline<target>;
+    manage_ = &callback::manage_inline<target>;
+}
+
+// The storage holds a pointer to the allocated target.
+template <typename Result, typename... Args>
+template <typename Function>
+void callback<Result(Args...)>::construct(Function&& function,
+    std::false_type)
+{
+    typedef typename std::decay<Function>::type target;
+    *reinterpret_cast<target**>(&storage_) =
+        new target(std::forward<Function>(function));
+    invoke_ = &callback::invoke_allocated<target>;
+    manage_ = &callback::manage_allocated<target>;
+}
+
+template <typename Result, typename... Args>
+template <typename Function>
+Result callback<Result(Args...)>::invoke_inline(void* target, Args&&... args)
+{
+    auto& function = *static_cast<Function*>(target);
+    return function(std::forward<Args>(args)...);
+}
+
+template <typename Result, typename... Args>
+template <typename Function>
+Result callback<Result(Args...)>::invoke_allocated(void* target,
+    Args&&... args)
+{
+    auto& function = **static_cast<Function**>(target);
+    return function(std::forward<Args>(args)...);
+}
+
+template <typename Result, typename... Args>
+template <typename Function>
+bool callback<Result(Args...)>::manage_inline(operation action, void* from,
+    void* to)
+{
+    const auto source = static_cast<Function*>(from);
+
+    switch (action)
+    {
+        case operation::copy:
+            new (to) Function(*source);
+            break;
+        case operation::move:
+            new (to) Function(std::move(*source));
+            source->~Function();
+            break;
+        case operation::destroy:
+            source->~Function();
+            break;
+        case operation::query:
+            break;
+    }
+
+    return true;
+}
+
+template <typename Result, typename... Args>
+template <typename Function>
+bool callback<Result(Args...)>::manage_allocated(operation action,
+    void* from, void* to)
+{
+    const auto source = static_cast<Function**>(from);
+
+    switch (action)
+    {
+        case operation::copy:
+            *static_cast<Function**>(to) = new Function(**source);
+            break;
+        case operation::move:
+            *static_cast<Function**>(to) = *source;
+            break;
+        case operation::destroy:
+            delete *source;
+            break;
+        case operation::query:
+            break;
+    }
+
+    return false;
+}
+
+// The other is left empty.
+template <typename Result, typename... Args>
+void callback<Result(Args...)>::take(callback& other)
+{
+    if (other.manage_ == nullptr)
+        return;
+
+    other.manage_(operation::move, &other.storage_, &storage_);
+    invoke_ = other.invoke_;
+    manage_ = other.manage_;
+    other.invoke_ = nullptr;
+    other.manage_ = nullptr;
+}
+
+template <typename Result, typename... Args>
+void callback<Result(Args...)>::reset()
+{
+    if (manage_ == nullptr)
+        return;
+
+    manage_(operation::destroy, &storage_, nullptr);
+    invoke_ = nullptr;
+    manage_ = nullptr;
+}
+
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_RING_BUFFER_IPP
+#define LIBBITCOIN_RING_BUFFER_IPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace libbitcoin {
+
+template <typename Type>
+ring_buffer<Type>::ring_buffer(size_t capacity)
+  : mask_(to_capacity(capacity) - 1),
+    cells_(new cell[mask_ + 1]),
+    tail_(0),
+    head_(0)
+{
+    // A cell is free for the producer at position when its sequence matches.
+    for (size_t position = 0; position <= mask_; ++position)
+        cells_[position].sequence.store(position, std::memory_order_relaxed);
+}
+
+template <typename Type>
+size_t ring_buffer<Type>::to_capacity(size_t minimum)
+{
+    size_t capacity = 1;
+    while (capacity < minimum)
+        capacity <<= 1;
+
+    return capacity;
+}
+
+template <typename Type>
+size_t ring_buffer<Type>::capacity() const
+{
+    return mask_ + 1;
+}
+
+template <typename Type>
+bool ring_buffer<Type>::push(Type&& value)
+{
+    auto position = tail_.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        auto& target = cells_[position & mask_];
+        const auto sequence = target.sequence.load(std::memory_order_acquire);
+        const auto lag = static_cast<intptr_t>(sequence) -
+            static_cast<intptr_t>(position);
+
+        if (lag == 0)
+        {
+            if (!tail_.compare_exchange_weak(position, position + 1,
+                std::memory_order_relaxed))
+                continue;
+
+            target.value = std::move(value);
+            target.sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        // The cell has not yet been consumed since the previous lap.
+        if (lag < 0)
+            return false;
+
+        position = tail_.load(std::memory_order_relaxed);
+    }
+}
+
+template <typename Type>
+bool ring_buffer<Type>::pop(Type& out)
+{
+    auto& source = cells_[head_ & mask_];
+    const auto sequence = source.sequence.load(std::memory_order_acquire);
+
+    if (sequence != head_ + 1)
+        return false;
+
+    out = std::move(source.value);
+    source.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+    ++head_;
+    return true;
+}
+
+} // namespace libbitcoin
+
+#endif
@@ -20,8 +20,8 @@
 #ifndef LIBBITCOIN_SUBSCRIBER_IPP
 #define LIBBITCOIN_SUBSCRIBER_IPP
 
-#include <functional>
 #include <memory>
+#include <utility>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/dispatcher.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
@@ -39,7 +39,7 @@ template <typename... Args>
 void subscriber<Args...>::subscribe(handler notifier)
 {
     dispatch_.ordered(&subscriber<Args...>::do_subscribe,
-        this->shared_from_this(), notifier);
+        this->shared_from_this(), std::move(notifier));
 }
 
 template <typename... Args>
@@ -52,7 +52,7 @@ void subscriber<Args...>::relay(Args... args)
 template <typename... Args>
 void subscriber<Args...>::do_subscribe(handler notifier)
 {
-    subscriptions_.push_back(notifier);
+    subscriptions_.push_back(std::move(notifier));
 }
 
 template <typename... Args>
@@ -61,9 +61,10 @@ void subscriber<Args...>::do_relay(Args... args)
     if (subscriptions_.empty())
         return;
 
-    const auto subscriptions_copy = subscriptions_;
-    subscriptions_.clear();
-    for (const auto notifier: subscriptions_copy)
+    // Handlers are moved out, not copied, as each is notified only once.
+    list subscriptions;
+    subscriptions.swap(subscriptions_);
+    for (const auto& notifier: subscriptions)
         notifier(args...);
 }
 
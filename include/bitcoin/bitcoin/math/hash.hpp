@@ -21,11 +21,13 @@
 #define LIBBITCOIN_HASH_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
 
 namespace libbitcoin {
 
@@ -152,17 +154,42 @@ BC_API short_hash bitcoin_short_hash(data_slice data);
 BC_API data_chunk scrypt(data_slice data, data_slice salt, uint64_t N,
     uint32_t p, uint32_t r, size_t length);
 
-/// Make hash_digest and short_hash hashable for std::*map variants
+/// Make hash_digest and short_hash hashable for std::*map variants.
+/// Digests are uniformly distributed, so the leading word of the digest is
+/// returned directly, without allocation or rehashing.
 template <typename HashType>
 struct BC_API std_hash_wrapper
 {
     size_t operator()(const HashType& hash) const
     {
-        std::hash<std::string> functor;
-        return functor(std::string(std::begin(hash), std::end(hash)));
+        static_assert(sizeof(HashType) >= sizeof(size_t), "short digest");
+        return from_little_endian_unsafe<size_t>(hash.begin());
     }
 };
 
+/// A hasher for std::*map variants keyed by digests that an adversary may
+/// choose, such as unconfirmed transaction hashes. The whole digest is mixed
+/// with a secret salt, so that bucket collisions cannot be precomputed.
+/// This is a keyed mix for table distribution, not a message authenticator.
+class BC_API salted_hash
+{
+public:
+    /// Construct with a salt from the operating system entropy source.
+    salted_hash();
+
+    /// Construct with the given salt, for reproducible distribution.
+    salted_hash(uint64_t salt);
+
+    size_t operator()(const short_hash& hash) const;
+    size_t operator()(const hash_digest& hash) const;
+    size_t operator()(const long_hash& hash) const;
+
+private:
+    size_t mix(const uint8_t* data, size_t size) const;
+
+    uint64_t salt_;
+};
+
 } // namespace libbitcoin
 
 /// Extend std namespace with our hash wrappers
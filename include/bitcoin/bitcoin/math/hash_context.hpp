@@ -0,0 +1,286 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_HASH_CONTEXT_HPP
+#define LIBBITCOIN_HASH_CONTEXT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/writer.hpp>
+
+namespace libbitcoin {
+
+/**
+ * Base class of the incremental hash contexts.
+ *
+ * Implements the writer interface, so that any to_data(writer&) can be
+ * hashed directly without first serializing to a data_chunk. Copying a
+ * context captures its intermediate state (midstate), which allows a
+ * common prefix to be hashed once and then extended many times.
+ * The state of the external implementation is held inline, so contexts
+ * never allocate. Hash contexts are not threadsafe.
+ *
+ * @code
+ *  bitcoin_hash_context context;
+ *  tx.to_data(context);
+ *  const auto hash = context.finalize();
+ * @endcode
+ */
+class BC_API hash_writer
+  : public writer
+{
+public:
+    virtual ~hash_writer();
+
+    /**
+     * Append data to the hash.
+     */
+    void update(data_slice data);
+    void update(const uint8_t* data, size_t size);
+
+    /**
+     * Discard all appended data, restoring the initial (keyed) state.
+     */
+    virtual void reset() = 0;
+
+    operator bool() const;
+    bool operator!() const;
+
+    void write_byte(uint8_t value);
+    void write_data(const data_chunk& data);
+    void write_data(const uint8_t* data, size_t size);
+    void write_hash(const hash_digest& value);
+    void write_short_hash(const short_hash& value);
+
+    // These write data in little endian format:
+    void write_2_bytes_little_endian(uint16_t value);
+    void write_4_bytes_little_endian(uint32_t value);
+    void write_8_bytes_little_endian(uint64_t value);
+    void write_variable_uint_little_endian(uint64_t value);
+
+    // These write data in big endian format:
+    void write_2_bytes_big_endian(uint16_t value);
+    void write_4_bytes_big_endian(uint32_t value);
+    void write_8_bytes_big_endian(uint64_t value);
+    void write_variable_uint_big_endian(uint64_t value);
+
+    /**
+     * Write a fixed size string padded with zeroes.
+     */
+    void write_fixed_string(const std::string& value, size_t size);
+
+    /**
+     * Write a variable length string.
+     */
+    void write_string(const std::string& value);
+
+protected:
+    virtual void append(const uint8_t* data, size_t size) = 0;
+};
+
+/**
+ * Incremental sha1 hash context.
+ */
+class BC_API sha1_context
+  : public hash_writer
+{
+public:
+    sha1_context();
+
+    void reset();
+
+    /**
+     * Obtain the digest of the data appended since the last reset.
+     * The context is reset for reuse.
+     */
+    short_hash finalize();
+
+protected:
+    void append(const uint8_t* data, size_t size);
+
+private:
+    // The SHA1CTX of the external implementation.
+    std::aligned_storage<96>::type context_;
+};
+
+/**
+ * Incremental ripemd160 hash context.
+ */
+class BC_API ripemd160_context
+  : public hash_writer
+{
+public:
+    ripemd160_context();
+
+    void reset();
+
+    /**
+     * Obtain the digest of the data appended since the last reset.
+     * The context is reset for reuse.
+     */
+    short_hash finalize();
+
+protected:
+    void append(const uint8_t* data, size_t size);
+
+private:
+    // The RMD160CTX of the external implementation.
+    std::aligned_storage<96>::type context_;
+};
+
+/**
+ * Incremental sha256 hash context.
+ */
+class BC_API sha256_context
+  : public hash_writer
+{
+public:
+    sha256_context();
+
+    void reset();
+
+    /**
+     * Obtain the digest of the data appended since the last reset.
+     * The context is reset for reuse.
+     */
+    hash_digest finalize();
+
+protected:
+    void append(const uint8_t* data, size_t size);
+
+private:
+    // The SHA256CTX of the external implementation.
+    std::aligned_storage<104>::type context_;
+};
+
+/**
+ * Incremental sha512 hash context.
+ */
+class BC_API sha512_context
+  : public hash_writer
+{
+public:
+    sha512_context();
+
+    void reset();
+
+    /**
+     * Obtain the digest of the data appended since the last reset.
+     * The context is reset for reuse.
+     */
+    long_hash finalize();
+
+protected:
+    void append(const uint8_t* data, size_t size);
+
+private:
+    // The SHA512CTX of the external implementation.
+    std::aligned_storage<208>::type context_;
+};
+
+/**
+ * Incremental hmac-sha256 hash context.
+ * The key schedule is computed once on construction and retained, so that
+ * reset does not rehash the key.
+ */
+class BC_API hmac_sha256_context
+  : public hash_writer
+{
+public:
+    hmac_sha256_context(data_slice key);
+    ~hmac_sha256_context();
+
+    void reset();
+
+    /**
+     * Obtain the digest of the data appended since the last reset.
+     * The context is reset for reuse with the same key.
+     */
+    hash_digest finalize();
+
+protected:
+    void append(const uint8_t* data, size_t size);
+
+private:
+    // The keyed and current HMACSHA256CTX of the external implementation.
+    typedef std::aligned_storage<312>::type state;
+    state keyed_;
+    state context_;
+};
+
+/**
+ * Incremental hmac-sha512 hash context.
+ * The key schedule is computed once on construction and retained, so that
+ * reset does not rehash the key.
+ */
+class BC_API hmac_sha512_context
+  : public hash_writer
+{
+public:
+    hmac_sha512_context(data_slice key);
+    ~hmac_sha512_context();
+
+    void reset();
+
+    /**
+     * Obtain the digest of the data appended since the last reset.
+     * The context is reset for reuse with the same key.
+     */
+    long_hash finalize();
+
+protected:
+    void append(const uint8_t* data, size_t size);
+
+private:
+    // The keyed and current HMACSHA512CTX of the external implementation.
+    typedef std::aligned_storage<416>::type state;
+    state keyed_;
+    state context_;
+};
+
+/**
+ * Incremental bitcoin hash context, sha256(sha256(data)).
+ */
+class BC_API bitcoin_hash_context
+  : public hash_writer
+{
+public:
+    void reset();
+
+    /**
+     * Obtain the digest of the data appended since the last reset.
+     * The context is reset for reuse.
+     */
+    hash_digest finalize();
+
+protected:
+    void append(const uint8_t* data, size_t size);
+
+private:
+    sha256_context context_;
+};
+
+} // namespace libbitcoin
+
+#endif
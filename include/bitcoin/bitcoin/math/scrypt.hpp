@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SCRYPT_HPP
+#define LIBBITCOIN_SCRYPT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+/**
+ * A reusable scrypt implementation.
+ *
+ * The p independent lanes of each hash are mixed concurrently on up to the
+ * configured number of threads, and the working memory of each thread is
+ * retained for subsequent calls. Peak memory is 128 * r * N bytes for each
+ * thread in use, so the thread count also bounds memory consumption.
+ * A context is not threadsafe, use one context per calling thread.
+ */
+class BC_API scrypt_context
+{
+public:
+    /**
+     * Construct a context.
+     * @param[in]  threads  The maximum number of threads used to compute the
+     *                      lanes of a hash, zero for hardware concurrency.
+     */
+    scrypt_context(size_t threads=0);
+
+    /**
+     * Clear and release the retained working memory.
+     */
+    ~scrypt_context();
+
+    /**
+     * The working memory required by each thread for the parameters.
+     */
+    static size_t scratch_size(uint64_t N, uint32_t r);
+
+    /**
+     * Generate a scrypt hash of specified length.
+     * Throws if the parameters are invalid or memory cannot be allocated.
+     * N must be a power of two greater than one, as each step of the mix
+     * computes two blocks.
+     *
+     * scrypt(data, salt, params)
+     */
+    data_chunk hash(data_slice data, data_slice salt, uint64_t N, uint32_t p,
+        uint32_t r, size_t length);
+
+    /**
+     * Generate a scrypt hash to fill a byte array.
+     *
+     * scrypt(data, salt, params)
+     */
+    template <size_t Size>
+    byte_array<Size> hash(data_slice data, data_slice salt, uint64_t N,
+        uint32_t p, uint32_t r);
+
+    /**
+     * The maximum number of threads used to compute the lanes of a hash.
+     */
+    size_t threads() const;
+
+    /**
+     * Clear and release the retained working memory.
+     */
+    void clear();
+
+private:
+    void reserve(size_t threads, size_t size);
+
+    const size_t threads_;
+    std::vector<data_chunk> scratch_;
+};
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/math/scrypt.ipp>
+
+#endif
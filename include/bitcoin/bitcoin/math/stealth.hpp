@@ -20,6 +20,7 @@
 #ifndef LIBBITCOIN_STEALTH_HPP
 #define LIBBITCOIN_STEALTH_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
@@ -44,8 +45,11 @@ BC_API bool create_ephemeral_key(ec_secret& out_secret,
 
 /// Create an ephemeral public key from the provided seed with the
 /// null-data script data value that produces the desired filter prefix.
+/// The nonce search is divided over threads, where zero implies one per
+/// core, and the result does not depend upon the number of threads.
 BC_API bool create_stealth_data(data_chunk& out_stealth_data,
-    ec_secret& out_secret, const binary_type& filter, const data_chunk& seed);
+    ec_secret& out_secret, const binary_type& filter, const data_chunk& seed,
+    size_t threads=1);
 
 /// Extract the stealth ephemeral public key from an output script.
 BC_API bool extract_ephemeral_key(ec_compressed& out_ephemeral_public_key,
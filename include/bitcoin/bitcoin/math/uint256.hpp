@@ -13,6 +13,7 @@
 #include <string>
 #include <string.h>
 #include <vector>
+#include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 
@@ -27,57 +28,47 @@ public:
     }
 };
 
-/** Template base class for unsigned big integers. */
+/**
+ * Template base class for fixed width unsigned big integers.
+ * The value is stored in 64 bit limbs, least significant first. All
+ * arithmetic is modulo 2^BITS. On little-endian hosts the byte range
+ * [begin(), end()) is the little-endian encoding of the value.
+ * Operations are not constant time (division and comparison depend upon
+ * the values), which suits public chain values but not secrets.
+ */
 template <unsigned int BITS>
 class BC_API base_uint
 {
 protected:
+    static_assert(BITS % 64 == 0, "BITS must be a multiple of 64");
+
     enum 
     { 
-        WIDTH = BITS / 32
+        WIDTH = BITS / 64
     };
 
-    uint32_t pn[WIDTH];
+    uint64_t pn[WIDTH];
 
 public:
-
-    base_uint()
-    {
-        for (int i = 0; i < WIDTH; i++)
-            pn[i] = 0;
-    }
-
-    base_uint(const base_uint& b)
+    BC_CONSTFUNC base_uint()
+      : pn{}
     {
-        for (int i = 0; i < WIDTH; i++)
-            pn[i] = b.pn[i];
     }
 
-    base_uint& operator=(const base_uint& b)
+    BC_CONSTFUNC base_uint(uint64_t b)
+      : pn{ b }
     {
-        for (int i = 0; i < WIDTH; i++)
-            pn[i] = b.pn[i];
-
-        return *this;
-    }
-
-    base_uint(uint64_t b)
-    {
-        pn[0] = (unsigned int)b;
-        pn[1] = (unsigned int)(b >> 32);
-        for (int i = 2; i < WIDTH; i++)
-            pn[i] = 0;
     }
 
     explicit base_uint(const std::vector<unsigned char>& vch);
 
     bool operator!() const
     {
+        uint64_t any = 0;
         for (int i = 0; i < WIDTH; i++)
-            if (pn[i] != 0)
-                return false;
+            any |= pn[i];
 
-        return true;
+        return any == 0;
     }
 
     const base_uint operator~() const
@@ -95,15 +86,14 @@ public:
         for (int i = 0; i < WIDTH; i++)
             ret.pn[i] = ~pn[i];
 
-        ret++;
+        ++ret;
         return ret;
     }
 
     base_uint& operator=(uint64_t b)
     {
-        pn[0] = (unsigned int)b;
-        pn[1] = (unsigned int)(b >> 32);
-        for (int i = 2; i < WIDTH; i++)
+        pn[0] = b;
+        for (int i = 1; i < WIDTH; i++)
             pn[i] = 0;
 
         return *this;
@@ -135,15 +125,13 @@ public:
 
     base_uint& operator^=(uint64_t b)
     {
-        pn[0] ^= (unsigned int)b;
-        pn[1] ^= (unsigned int)(b >> 32);
+        pn[0] ^= b;
         return *this;
     }
 
     base_uint& operator|=(uint64_t b)
     {
-        pn[0] |= (unsigned int)b;
-        pn[1] |= (unsigned int)(b >> 32);
+        pn[0] |= b;
         return *this;
     }
 
@@ -155,9 +143,10 @@ public:
         uint64_t carry = 0;
         for (int i = 0; i < WIDTH; i++)
         {
-            uint64_t n = carry + pn[i] + b.pn[i];
-            pn[i] = n & 0xffffffff;
-            carry = n >> 32;
+            const uint64_t sum = pn[i] + b.pn[i];
+            const uint64_t total = sum + carry;
+            carry = (sum < pn[i] ? 1 : 0) + (total < sum ? 1 : 0);
+            pn[i] = total;
         }
 
         return *this;
@@ -165,24 +154,27 @@ public:
 
     base_uint& operator-=(const base_uint& b)
     {
-        *this += -b;
+        uint64_t borrow = 0;
+        for (int i = 0; i < WIDTH; i++)
+        {
+            const uint64_t difference = pn[i] - b.pn[i];
+            const uint64_t total = difference - borrow;
+            borrow = (pn[i] < b.pn[i] ? 1 : 0) +
+                (difference < borrow ? 1 : 0);
+            pn[i] = total;
+        }
+
         return *this;
     }
 
     base_uint& operator+=(uint64_t b64)
     {
-        base_uint b;
-        b = b64;
-        *this += b;
-        return *this;
+        return *this += base_uint(b64);
     }
 
     base_uint& operator-=(uint64_t b64)
     {
-        base_uint b;
-        b = b64;
-        *this += -b;
-        return *this;
+        return *this -= base_uint(b64);
     }
 
     base_uint& operator*=(uint32_t b32);
@@ -211,7 +203,7 @@ public:
     {
         // prefix operator
         int i = 0;
-        while (--pn[i] == (uint32_t)-1 && i < WIDTH - 1)
+        while (--pn[i] == (uint64_t)-1 && i < WIDTH - 1)
             i++;
 
         return *this;
@@ -280,10 +272,9 @@ public:
      */
     unsigned int bits() const;
 
-    uint64_t GetLow64() const
+    BC_CONSTFUNC uint64_t GetLow64() const
     {
-        BITCOIN_ASSERT(WIDTH >= 2);
-        return pn[0] | (uint64_t)pn[1] << 32;
+        return pn[0];
     }
 };
 
@@ -291,13 +282,18 @@ public:
 class BC_API uint256_t : public base_uint<256>
 {
 public:
-    uint256_t()
+    BC_CONSTFUNC uint256_t()
+      : base_uint<256>()
     {
     }
-    uint256_t(const base_uint<256>& b) : base_uint<256>(b)
+
+    BC_CONSTFUNC uint256_t(const base_uint<256>& b)
+      : base_uint<256>(b)
     {
     }
-    uint256_t(uint64_t b) : base_uint<256>(b)
+
+    BC_CONSTFUNC uint256_t(uint64_t b)
+      : base_uint<256>(b)
     {
     }
 
@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <boost/asio.hpp>
+#include <boost/asio/coroutine.hpp>
 #include <bitcoin/bitcoin/compat.hpp>
 
 // Convenience namespace for commonly used boost asio aliases.
@@ -39,6 +40,7 @@ typedef boost::asio::ip::tcp::endpoint endpoint;
 typedef boost::asio::io_service service;
 typedef boost::asio::deadline_timer timer;
 typedef boost::posix_time::time_duration duration;
+typedef boost::asio::coroutine coroutine;
 
 typedef tcp::socket socket;
 typedef tcp::acceptor acceptor;
@@ -26,6 +26,7 @@
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/message/address.hpp>
 #include <bitcoin/bitcoin/message/get_address.hpp>
+#include <bitcoin/bitcoin/network/asio.hpp>
 #include <bitcoin/bitcoin/network/channel.hpp>
 #include <bitcoin/bitcoin/network/protocol_events.hpp>
 #include <bitcoin/bitcoin/network/p2p.hpp>
@@ -60,16 +61,18 @@ public:
     void start(const settings& settings);
 
 private:
-    void handle_receive_address(const code& ec,
-        const message::address& address);
-    void handle_receive_get_address(const code& ec,
-        const message::get_address& message);
+    void receive_addresses(const code& ec);
+    void respond_get_address(const code& ec);
     void handle_send_address(const code& ec);
     void handle_send_get_address(const code& ec);
     void handle_store_addresses(const code& ec);
 
     p2p& network_;
     message::address self_;
+    asio::coroutine receiver_;
+    asio::coroutine responder_;
+    const message::address* address_;
+    const message::get_address* get_address_;
 };
 
 } // namespace network
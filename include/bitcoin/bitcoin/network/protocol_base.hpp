@@ -102,6 +102,19 @@ protected:
                 shared_from_base<Protocol>(), std::forward<Args>(args)...));
     }
 
+    /// Point the member at the next message of its type and then resume the
+    /// routine, as the await of a stackless coroutine. The message is not
+    /// copied, so the member is only valid until the routine next yields.
+    /// The coroutine state is a protocol member, so there is no frame.
+    template <class Protocol, class Message>
+    void receive(const Message* Protocol::*member,
+        void (Protocol::*routine)(const code&))
+    {
+        subscribe<Protocol, Message>(
+            &protocol_base::handle_receive<Protocol, Message>,
+            std::placeholders::_1, std::placeholders::_2, member, routine);
+    }
+
     /// Subscribe to the channel stop.
     template <class Protocol, typename Handler, typename... Args>
     void subscribe_stop(Handler&& handler, Args&&... args)
@@ -134,6 +147,17 @@ protected:
     bool stopped() const;
 
 private:
+    template <class Protocol, class Message>
+    void handle_receive(const code& ec, const Message& message,
+        const Message* Protocol::*member,
+        void (Protocol::*routine)(const code&))
+    {
+        auto& self = static_cast<Protocol&>(*this);
+        self.*member = &message;
+        (self.*routine)(ec);
+        self.*member = nullptr;
+    }
+
     threadpool& pool_;
     dispatcher dispatch_;
     channel::ptr channel_;
@@ -148,6 +172,8 @@ private:
     bind<PROTOCOL>(&PROTOCOL::method, p1, p2)
 #define CALL1(method, p1) \
     call<PROTOCOL>(&PROTOCOL::method, p1)
+#define RECEIVE(member, routine) \
+    receive<PROTOCOL>(&PROTOCOL::member, &PROTOCOL::routine)
 #define SEND1(message, method, p1) \
     send<PROTOCOL>(message, &PROTOCOL::method, p1)
 #define SUBSCRIBE_STOP1(method, p1) \
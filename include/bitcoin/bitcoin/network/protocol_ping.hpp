@@ -25,6 +25,7 @@
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/message/ping.hpp>
 #include <bitcoin/bitcoin/message/pong.hpp>
+#include <bitcoin/bitcoin/network/asio.hpp>
 #include <bitcoin/bitcoin/network/channel.hpp>
 #include <bitcoin/bitcoin/network/p2p.hpp>
 #include <bitcoin/bitcoin/network/protocol_timer.hpp>
@@ -59,11 +60,14 @@ public:
 
 private:
     void send_ping(const code& ec);
-    void handle_receive_ping(const code& ec, const message::ping& message);
+    void respond_ping(const code& ec);
     void handle_receive_pong(const code& ec, const message::pong& message,
         uint64_t nonce);
     void handle_send_ping(const code& ec);
     void handle_send_pong(const code& ec);
+
+    asio::coroutine responder_;
+    const message::ping* ping_;
 };
 
 } // namespace network
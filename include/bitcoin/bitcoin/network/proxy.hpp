@@ -25,6 +25,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <boost/array.hpp>
 #include <boost/date_time.hpp>
 #include <boost/iostreams/stream.hpp>
@@ -35,6 +36,7 @@
 #include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/messages.hpp>
 #include <bitcoin/bitcoin/network/message_subscriber.hpp>
+#include <bitcoin/bitcoin/utility/callback.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/dispatcher.hpp>
@@ -51,7 +53,7 @@ class BC_API proxy
 {
 public:
     typedef subscriber<const code&> stop_subscriber;
-    typedef std::function<void(const code&)> result_handler;
+    typedef callback<void(const code&)> result_handler;
 
     template <class Derived>
     std::shared_ptr<Derived> shared_from_base()
@@ -77,9 +79,9 @@ public:
 
         using namespace message;
         const auto bytes = serialize(std::forward<Message>(packet), magic_);
-        const auto handle_send = std::forward<Handler>(handler);
+        result_handler handle_send(std::forward<Handler>(handler));
         dispatch_.ordered(&proxy::do_send,
-            shared_from_this(), bytes, handle_send, packet.command);
+            shared_from_this(), bytes, std::move(handle_send), packet.command);
     }
 
     template <class Message, typename Handler>
@@ -125,7 +127,8 @@ private:
     void handle_read_payload(const boost_code& ec, size_t,
         const message::heading& heading);
 
-    void call_handle_send(const boost_code& ec, result_handler handler);
+    void call_handle_send(const boost_code& ec,
+        const result_handler& handler);
     void do_send(const data_chunk& message, result_handler handler,
         const std::string& command);
 
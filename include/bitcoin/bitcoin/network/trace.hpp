@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NETWORK_TRACE_HPP
+#define LIBBITCOIN_NETWORK_TRACE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <bitcoin/bitcoin/compat.hpp>
+#include <bitcoin/bitcoin/config/authority.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/message/network_address.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// The kinds of protocol event recorded in a trace.
+enum class trace_event : uint8_t
+{
+    message_received,
+    message_sent,
+    channel_stopped
+};
+
+/// A fixed size protocol event, serialized in little endian byte order.
+struct BC_API trace_record
+{
+    static BC_CONSTEXPR size_t command_size = 12;
+    static BC_CONSTEXPR size_t serialized_size = 48;
+
+    static trace_record factory_from_data(const data_chunk& data);
+    data_chunk to_data() const;
+
+    /// Microseconds since the unix epoch.
+    uint64_t timestamp;
+
+    /// Microseconds spent handling the message, zero if not measured.
+    uint32_t duration;
+
+    uint32_t payload_size;
+    trace_event event;
+    uint16_t port;
+    message::ip_address ip;
+
+    /// The message command, zero padded as on the wire.
+    byte_array<command_size> command;
+};
+
+/**
+ * An always-on binary trace of protocol events.
+ * Recording is lock-free and allocation-free: events are queued by the
+ * calling thread to one of several ring buffers (chosen by thread id) and a
+ * background thread copies them into a memory-mapped file. The file holds
+ * a fixed number of records, overwriting the oldest once full, so that a
+ * trace may run indefinitely in production. Use the libbitcoin_trace tool
+ * (or read) to decode a trace file.
+ */
+class BC_API trace
+{
+public:
+    typedef std::vector<trace_record> list;
+
+    /// The default number of records held by a trace file.
+    static BC_CONSTEXPR size_t default_capacity = 1024 * 1024;
+
+    /// Begin tracing to the file, which is created or replaced.
+    static bool start(const boost::filesystem::path& path,
+        size_t capacity=default_capacity);
+
+    /// Write queued records and close the file.
+    static void stop();
+
+    /// True if events are being recorded, test this before recording.
+    static bool enabled();
+
+    /// The number of records dropped because a queue was full.
+    static size_t dropped();
+
+    /// Record the event, which is dropped if tracing is not enabled.
+    static void record(trace_event event, const config::authority& authority,
+        const std::string& command, size_t payload_size,
+        uint32_t duration=0);
+
+    /// Read the records of a trace file, oldest first.
+    static bool read(list& out, const boost::filesystem::path& path);
+
+    /// The current time in microseconds since the unix epoch.
+    static uint64_t now();
+
+    /// A monotonic time in microseconds, for measuring a duration.
+    static uint64_t ticks();
+
+    /// Convert the event value to English text.
+    static std::string to_text(trace_event event);
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
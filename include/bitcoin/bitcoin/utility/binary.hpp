@@ -52,6 +52,10 @@ public:
     void shift_right(size_type distance);
     binary_type substring(size_type first, size_type length=max_size_t) const;
 
+    /// Write the substring into out, reusing its storage (out may be this).
+    void substring(binary_type& out, size_type first,
+        size_type length=max_size_t) const;
+
     bool is_prefix_of(data_slice field) const;
     bool is_prefix_of(const uint32_t field) const;
     bool is_prefix_of(const binary_type& field) const;
@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CALLBACK_HPP
+#define LIBBITCOIN_CALLBACK_HPP
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <bitcoin/bitcoin/compat.hpp>
+
+namespace libbitcoin {
+
+template <typename Signature>
+class callback;
+
+/**
+ * A function object with inline storage, for handlers.
+ * Unlike std::function this does not allocate for a target of up to
+ * capacity bytes, which holds a bind of a member function, a shared pointer
+ * and a few arguments, or a delegate of one. Larger targets, and those that
+ * may throw on move, are allocated. Copies copy the target, as asio requires
+ * copyable handlers, so moves should be preferred. A null function pointer
+ * or an empty function object yields an empty callback, and invoking an
+ * empty callback throws std::bad_function_call.
+ */
+template <typename Result, typename... Args>
+class callback<Result(Args...)>
+{
+public:
+    static const size_t capacity = 64;
+
+    callback();
+    callback(std::nullptr_t);
+
+private:
+    // True if the target can be invoked with Args, returning Result.
+    template <typename Function>
+    struct callable
+    {
+    private:
+        template <typename Target, typename Return = decltype(
+            std::declval<Target&>()(std::declval<Args>()...))>
+        static std::integral_constant<bool, std::is_void<Result>::value ||
+            std::is_convertible<Return, Result>::value> test(int);
+
+        template <typename Target>
+        static std::false_type test(...);
+
+    public:
+        static const bool value = decltype(test<Function>(0))::value;
+    };
+
+public:
+    template <typename Function, typename = typename std::enable_if<
+        !std::is_same<typename std::decay<Function>::type,
+            callback>::value &&
+        callable<typename std::decay<Function>::type>::value>::type>
+    callback(Function&& function);
+
+    callback(const callback& other);
+    callback(callback&& other) BC_NOEXCEPT;
+    callback& operator=(const callback& other);
+    callback& operator=(callback&& other) BC_NOEXCEPT;
+    ~callback();
+
+    /// True if there is a target.
+    explicit operator bool() const;
+
+    /// True if the target is stored without allocation.
+    bool is_inline() const;
+
+    /// Invoke the target.
+    Result operator()(Args... args) const;
+
+private:
+    typedef typename std::aligned_storage<capacity>::type storage;
+
+    enum class operation
+    {
+        copy,
+        move,
+        destroy,
+        query
+    };
+
+    typedef Result (*invoker)(void* target, Args&&... args);
+    typedef bool (*manager)(operation action, void* from, void* to);
+
+    template <typename Function>
+    struct fits
+      : std::integral_constant<bool, sizeof(Function) <= capacity &&
+            std::alignment_of<Function>::value <=
+                std::alignment_of<storage>::value &&
+            std::is_nothrow_move_constructible<Function>::value>
+    {
+    };
+
+    template <typename Function>
+    static bool is_null(const Function& function);
+
+    template <typename Target>
+    static bool is_null(Target* function);
+
+    template <typename Signature>
+    static bool is_null(const std::function<Signature>& function);
+
+    template <typename Signature>
+    static bool is_null(const callback<Signature>& function);
+
+    template <typename Function>
+    void construct(Function&& function, std::true_type);
+
+    template <typename Function>
+    void construct(Function&& function, std::false_type);
+
+    template <typename Function>
+    static Result invoke_inline(void* target, Args&&... args);
+
+    template <typename Function>
+    static Result invoke_allocated(void* target, Args&&... args);
+
+    template <typename Function>
+    static bool manage_inline(operation action, void* from, void* to);
+
+    template <typename Function>
+    static bool manage_allocated(operation action, void* from, void* to);
+
+    void take(callback& other);
+    void reset();
+
+    invoker invoke_;
+    manager manage_;
+    mutable storage storage_;
+};
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/utility/callback.ipp>
+
+#endif
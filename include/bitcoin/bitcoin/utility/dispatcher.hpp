@@ -27,6 +27,7 @@
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/network/asio.hpp>
 #include <bitcoin/bitcoin/utility/delegates.hpp>
+#include <bitcoin/bitcoin/utility/scheduler.hpp>
 #include <bitcoin/bitcoin/utility/synchronizer.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
@@ -48,11 +49,15 @@ using std::placeholders::_1;
 /**
  * Convenience class for objects wishing to synchronize operations.
  * If the ios service is stopped jobs will not be dispatched.
+ * Given a scheduler, concurrent jobs (including those of parallel) run on
+ * its workers, leaving the service to network io and strand-ordered jobs.
+ * Jobs that a stopped scheduler refuses are posted to the service instead.
  */
 class BC_API dispatcher
 {
 public:
     dispatcher(threadpool& pool);
+    dispatcher(threadpool& pool, scheduler& executor);
 
     /**
      * Posts a job to the service. Concurrent and not ordered.
@@ -60,7 +65,22 @@ public:
     template <typename... Args>
     void concurrent(Args&&... args)
     {
-        service_.post(BIND_ARGS(args));
+        if (scheduler_ == nullptr)
+            service_.post(BIND_ARGS(args));
+        else
+            schedule(BIND_ARGS(args), task_priority::normal);
+    }
+
+    /**
+     * Posts a job ahead of normal jobs, given a scheduler. Not ordered.
+     */
+    template <typename... Args>
+    void prioritized(Args&&... args)
+    {
+        if (scheduler_ == nullptr)
+            service_.post(BIND_ARGS(args));
+        else
+            schedule(BIND_ARGS(args), task_priority::high);
     }
 
     /**
@@ -168,8 +188,11 @@ public:
     }
 
 private:
+    void schedule(scheduler::task&& job, task_priority priority);
+
     asio::service& service_;
     asio::service::strand strand_;
+    scheduler* scheduler_;
 };
 
 #undef FORWARD_ARGS
@@ -0,0 +1,199 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_INSTRUMENT_HPP
+#define LIBBITCOIN_INSTRUMENT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin/compat.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/network/asio.hpp>
+#include <bitcoin/bitcoin/utility/deadline.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+// Instrumentation of library hot paths is compiled in by --with-instrument,
+// which defines WITH_INSTRUMENT. Otherwise these macros expand to nothing.
+// BC_METRIC must be used at namespace scope (metrics are static objects).
+#ifdef WITH_INSTRUMENT
+    #define BC_INSTRUMENT_JOIN_(left, right) left##right
+    #define BC_INSTRUMENT_JOIN(left, right) BC_INSTRUMENT_JOIN_(left, right)
+    #define BC_METRIC(variable, name, kind) \
+        static bc::metric variable(name, bc::metric_kind::kind)
+    #define BC_INSTRUMENT_SCOPE(variable) \
+        const bc::scoped_timer BC_INSTRUMENT_JOIN(scoped_timer_, __LINE__)( \
+            variable)
+    #define BC_INSTRUMENT_RECORD(variable, value) variable.record(value)
+#else
+    #define BC_METRIC(variable, name, kind)
+    #define BC_INSTRUMENT_SCOPE(variable)
+    #define BC_INSTRUMENT_RECORD(variable, value)
+#endif
+
+namespace libbitcoin {
+
+enum class metric_kind
+{
+    /// Accumulates the number of records and the sum of recorded values.
+    counter,
+
+    /// A counter that also buckets recorded values by power of two.
+    histogram
+};
+
+/**
+ * An aggregation of a metric at the time of the snapshot.
+ * Histogram bucket n counts values in [2^(n-1), 2^n), bucket zero counts 0.
+ */
+struct BC_API metric_snapshot
+{
+    /// The mean recorded value, zero if there are no records.
+    double mean() const;
+
+    /// The upper bound of the bucket containing the given fraction (0..1).
+    uint64_t percentile(double fraction) const;
+
+    std::string name;
+    metric_kind kind;
+    uint64_t count;
+    uint64_t sum;
+    std::vector<uint64_t> buckets;
+};
+
+/**
+ * A named, lock-free metric. Records are spread over a fixed set of shards
+ * selected by thread id, so that concurrent threads rarely contend on one
+ * cache line, and shards are summed on snapshot.
+ * Metrics must have static storage duration, as each registers itself in
+ * a list of all metrics upon construction and is never unregistered.
+ */
+class BC_API metric
+{
+public:
+    static BC_CONSTEXPR size_t bucket_count = 48;
+    static BC_CONSTEXPR size_t shard_count = 16;
+
+    /// The first registered metric, for iteration via next().
+    static metric* first();
+
+    metric(const char* name, metric_kind kind);
+
+    /// This class is not copyable.
+    metric(const metric&) = delete;
+    void operator=(const metric&) = delete;
+
+    /// Record a value (timers record nanoseconds).
+    void record(uint64_t value=1);
+
+    /// Zeroize all shards, concurrent records may survive.
+    void reset();
+
+    const char* name() const;
+    metric_kind kind() const;
+    metric* next() const;
+    metric_snapshot snapshot() const;
+
+private:
+    struct shard
+    {
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> buckets[bucket_count];
+    };
+
+    static metric* first_;
+
+    const char* name_;
+    const metric_kind kind_;
+    metric* next_;
+    shard shards_[shard_count];
+};
+
+/**
+ * Records the lifetime of the instance in nanoseconds to a metric.
+ */
+class BC_API scoped_timer
+{
+public:
+    scoped_timer(metric& target);
+    ~scoped_timer();
+
+    /// This class is not copyable.
+    scoped_timer(const scoped_timer&) = delete;
+    void operator=(const scoped_timer&) = delete;
+
+private:
+    typedef std::chrono::steady_clock clock;
+
+    metric& metric_;
+    const clock::time_point start_;
+};
+
+/**
+ * Access to all registered metrics and their periodic snapshot.
+ */
+class BC_API instrument
+  : public std::enable_shared_from_this<instrument>
+{
+public:
+    typedef std::shared_ptr<instrument> ptr;
+    typedef std::vector<metric_snapshot> snapshots;
+    typedef std::function<void(const snapshots&)> handler;
+
+    /// Snapshot all metrics, in reverse order of registration.
+    static snapshots snapshot();
+
+    /// Reset all metrics.
+    static void reset();
+
+    /**
+     * Construct a periodic snapshot monitor.
+     * @param[in]  pool    The thread pool used by the timer.
+     * @param[in]  period  The interval between snapshots.
+     * @param[in]  clear   Reset the metrics after each snapshot.
+     */
+    instrument(threadpool& pool, const asio::duration& period,
+        bool clear=false);
+
+    /// Invoke the handler with a snapshot once per period until stopped.
+    void start(handler handle);
+
+    /// Stop the monitor, the handler will not be invoked again.
+    void stop();
+
+private:
+    void handle_timer(const code& ec, handler handle);
+
+    const bool clear_;
+    bool stopped_;
+    deadline::ptr timer_;
+    std::mutex mutex_;
+};
+
+} // namespace libbitcoin
+
+#endif
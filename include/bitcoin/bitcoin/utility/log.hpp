@@ -20,10 +20,13 @@
 #ifndef LIBBITCOIN_LOG_HPP
 #define LIBBITCOIN_LOG_HPP
 
+#include <cstddef>
 #include <functional>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 
 namespace libbitcoin {
@@ -44,6 +47,9 @@ public:
     typedef std::function<void(level, const std::string&, const std::string&)>
         functor;
 
+    /// The default number of lines held by the background writer.
+    static BC_CONSTEXPR size_t default_capacity = 4096;
+
     log(level value, const std::string& domain);
     log(log&& other);
     ~log();
@@ -54,6 +60,29 @@ public:
     /// Convert the log level value to English text.
     static std::string to_text(level value);
 
+    /// Set the least level written for the domain, or for all domains that
+    /// have no level of their own if the domain is empty.
+    /// Set levels (like output functions) before logging begins.
+    static void set_minimum(level value, const std::string& domain="");
+
+    /// True if lines of the level and domain are formatted and written.
+    /// Levels below the minimum of the library build are never enabled.
+    static bool enabled(level value, const std::string& domain);
+
+    /// The output functor of the level, empty if the level has none.
+    static functor output_function(level value);
+
+    /// Queue lines to a background thread that calls the output functions,
+    /// so that logging never blocks on io. Lines are dropped if the queue
+    /// is full, and the calling thread writes if the writer is stopped.
+    static void start_writer(size_t capacity=default_capacity);
+
+    /// Write the queued lines and stop the background writer.
+    static void stop_writer();
+
+    /// The number of lines dropped because the writer queue was full.
+    static size_t dropped();
+
     // Stream to these functions.
     static log debug(const std::string& domain);
     static log info(const std::string& domain);
@@ -64,18 +93,21 @@ public:
     template <typename Type>
     log& operator<<(Type const& value)
     {
-        stream_ << value;
+        // Values streamed to a disabled log are not formatted.
+        if (enabled_)
+            *stream_ << value;
+
         return *this;
     }
 
     /// Set the output functor for this log instance.
+    /// An empty functor removes the output, so the level is not formatted.
     void set_output_function(functor value);
 
 private:
-    typedef std::map<level, functor> destinations;
+    typedef std::map<level, std::shared_ptr<functor>> destinations;
+    typedef std::map<std::string, level> minimums;
 
-    static void output_ignore(level value, const std::string& domain,
-        const std::string& body);
     static void output_cout(level value, const std::string& domain,
         const std::string& body);
     static void output_cerr(level value, const std::string& domain,
@@ -85,10 +117,14 @@ private:
         const std::string& domain, const std::string& body);
 
     static destinations destinations_;
+    static minimums minimums_;
+    static level minimum_;
 
+    // A disabled log holds neither the domain nor a stream.
     level level_;
+    bool enabled_;
     std::string domain_;
-    std::ostringstream stream_;
+    std::unique_ptr<std::ostringstream> stream_;
 };
 
 } // namespace libbitcoin
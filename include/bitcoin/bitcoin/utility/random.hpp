@@ -22,13 +22,55 @@
 
 #include <cstdint>
 #include <boost/date_time.hpp>
+#include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 
 namespace libbitcoin {
 
 /**
- * Generate a pseudo random number within the domain.
+ * Advance the seed and return its splitmix64 mix. This is deterministic and
+ * predictable, for expanding seeds and generating reproducible fixtures.
+ * @param[in,out]  seed  The generator state, advanced by each call.
+ * @return               The next 64 bit value.
+ */
+BC_API uint64_t splitmix64(uint64_t& seed);
+
+/**
+ * The xoshiro256** generator of Blackman and Vigna. This is fast and of high
+ * statistical quality but predictable, so it must never produce secrets.
+ * An instance is not thread safe. Satisfies UniformRandomBitGenerator.
+ */
+class BC_API xoshiro256
+{
+public:
+    typedef uint64_t result_type;
+
+    static BC_CONSTEXPR result_type min()
+    {
+        return 0;
+    }
+
+    static BC_CONSTEXPR result_type max()
+    {
+        return MAX_UINT64;
+    }
+
+    /// The seed is expanded to the 256 bit state using splitmix64.
+    explicit xoshiro256(uint64_t seed);
+
+    result_type operator()();
+
+private:
+    uint64_t state_[4];
+};
+
+/**
+ * Generate a pseudo random number within the domain, without a system call.
+ * Generators are seeded once from the random device and are shared by
+ * threads in shards. The outputs reveal the generator state, so this is not
+ * for keys, salts, nonces sent to peers or other values that must not be
+ * predicted.
  * @return  The 64 bit number (use % to subset domain).
  */
 BC_API uint64_t pseudo_random();
@@ -40,11 +82,31 @@ BC_API uint64_t pseudo_random();
 BC_API uint64_t nonzero_pseudo_random();
 
 /**
- * Fill a buffer with randomness using the default random engine.
+ * Fill a buffer from the operating system entropy source.
+ * This is equivalent to secure_random_fill.
  * @param[in]  chunk  The buffer to fill with randomness.
  */
 BC_API void pseudo_random_fill(data_chunk& chunk);
 
+/**
+ * Generate a random number from the operating system entropy source.
+ * This is slow (a system call per use) and is intended for key material.
+ * @return  The 64 bit number.
+ */
+BC_API uint64_t secure_random();
+
+/**
+ * Generate a non-zero random number from the operating system entropy source.
+ * @return  The 64 bit number.
+ */
+BC_API uint64_t nonzero_secure_random();
+
+/**
+ * Fill a buffer from the operating system entropy source, for key material.
+ * @param[in]  chunk  The buffer to fill with randomness.
+ */
+BC_API void secure_random_fill(data_chunk& chunk);
+
 /**
  * Convert a time duration to a value in the range [max/ratio, max].
  * @param[in]  maximum  The maximum value to return.
@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_RING_BUFFER_HPP
+#define LIBBITCOIN_RING_BUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <bitcoin/bitcoin/define.hpp>
+
+namespace libbitcoin {
+
+/**
+ * A bounded lock-free queue for many producers and a single consumer.
+ * Each cell carries a sequence number, so producers claim cells with a
+ * single compare-exchange and the consumer never contends with them.
+ * A full buffer rejects the value rather than blocking the producer.
+ */
+template <typename Type>
+class ring_buffer
+{
+public:
+    /// The capacity is rounded up to a power of two.
+    ring_buffer(size_t capacity);
+
+    ring_buffer(const ring_buffer&) = delete;
+    void operator=(const ring_buffer&) = delete;
+
+    /// Queue the value from any thread, false if the buffer is full.
+    bool push(Type&& value);
+
+    /// Dequeue the oldest value, from the consumer thread only.
+    bool pop(Type& out);
+
+    /// The number of values the buffer can hold.
+    size_t capacity() const;
+
+private:
+    struct cell
+    {
+        std::atomic<size_t> sequence;
+        Type value;
+    };
+
+    static size_t to_capacity(size_t minimum);
+
+    const size_t mask_;
+    std::unique_ptr<cell[]> cells_;
+    std::atomic<size_t> tail_;
+    size_t head_;
+};
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/utility/ring_buffer.ipp>
+
+#endif
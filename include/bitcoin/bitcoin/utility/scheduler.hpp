@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SCHEDULER_HPP
+#define LIBBITCOIN_SCHEDULER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/callback.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+
+enum class task_priority
+{
+    high,
+    normal
+};
+
+/**
+ * A work-stealing executor for cpu-bound tasks, kept apart from the network
+ * io_service so that computation and io do not contend on one queue.
+ * Each worker owns a pair of deques (high and normal priority). A worker
+ * runs its own most recent task first and, when idle, steals the oldest
+ * task of another worker. Tasks posted from outside of the workers are
+ * queued in a shared pair of deques that workers take from oldest first.
+ */
+class BC_API scheduler
+{
+public:
+    typedef callback<void()> task;
+
+    /**
+     * Construct and start the workers.
+     * @param[in]   number_threads  Number of workers, zero implies one per core.
+     * @param[in]   priority        Priority of the worker threads.
+     * @param[in]   pin             Pin each worker to a core, where supported.
+     */
+    scheduler(size_t number_threads=0,
+        thread_priority priority=thread_priority::normal, bool pin=false);
+
+    /**
+     * Completes outstanding tasks and joins the workers.
+     */
+    ~scheduler();
+
+    scheduler(const scheduler&) = delete;
+    void operator=(const scheduler&) = delete;
+
+    /**
+     * Queue a task. Returns false, without running the task, if the
+     * scheduler has been aborted, or if it has been shut down and the
+     * caller is not one of its workers.
+     */
+    bool post(task&& job, task_priority priority=task_priority::normal);
+
+    /**
+     * Abandon queued tasks. Workers terminate after any running task.
+     */
+    void abort();
+
+    /**
+     * Allow queued tasks to finish, then terminate the workers.
+     */
+    void shutdown();
+
+    /**
+     * Wait for all workers to terminate.
+     * Do not call this from within a task.
+     */
+    void join();
+
+    /**
+     * The number of workers.
+     */
+    size_t size() const;
+
+private:
+    struct queue
+    {
+        std::mutex mutex;
+        std::deque<task> high;
+        std::deque<task> normal;
+    };
+
+    static bool take_oldest(queue& source, task& out);
+
+    bool pop(size_t index, task& out);
+    bool pop_injected(task& out);
+    bool steal(size_t thief, task& out);
+    size_t current() const;
+    void run(size_t index);
+
+    std::vector<std::unique_ptr<queue>> queues_;
+    std::vector<std::thread> threads_;
+    std::vector<std::thread::id> workers_;
+
+    // Tasks posted from outside of the workers, taken in order.
+    queue injected_;
+
+    std::atomic<size_t> pending_;
+    std::atomic<size_t> sleeping_;
+    std::atomic<bool> stopped_;
+    std::atomic<bool> aborted_;
+
+    // Idle workers wait here, posters only lock when a worker is asleep.
+    std::mutex idle_mutex_;
+    std::condition_variable idle_;
+
+    // Workers start once their identities are recorded.
+    std::mutex start_mutex_;
+    std::condition_variable start_;
+    bool started_;
+};
+
+} // namespace libbitcoin
+
+#endif
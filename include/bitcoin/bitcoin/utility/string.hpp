@@ -26,6 +26,11 @@
 
 namespace libbitcoin {
 
+/**
+ * A list of strings.
+ */
+typedef std::vector<std::string> string_list;
+
 /**
  * Join a list of strings into a single string, in order.
  * @param[in]  words      The list of strings to join.
@@ -20,10 +20,10 @@
 #ifndef  LIBBITCOIN_SUBSCRIBER_HPP
 #define  LIBBITCOIN_SUBSCRIBER_HPP
 
-#include <functional>
 #include <memory>
 #include <vector>
 #include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/callback.hpp>
 #include <bitcoin/bitcoin/utility/dispatcher.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
@@ -35,7 +35,7 @@ class subscriber
     track<subscriber<Args...>>*/
 {
 public:
-    typedef std::function<void (Args...)> handler;
+    typedef callback<void (Args...)> handler;
     typedef std::shared_ptr<subscriber<Args...>> ptr;
 
     subscriber(threadpool& pool, const std::string& class_name,
@@ -20,94 +20,86 @@
 #ifndef LIBBITCOIN_SYNCHRONIZER_HPP
 #define LIBBITCOIN_SYNCHRONIZER_HPP
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
-#include <mutex>
+#include <string>
+#include <utility>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 
 namespace libbitcoin {
 
+/**
+ * Invokes the handler once the clearance count of calls is reached, or upon
+ * the first error (unless errors are suppressed). Further calls are ignored.
+ * Copies share a single control block, so copying allocates nothing and
+ * each call is a lock-free atomic countdown.
+ */
 template <typename Handler>
 class synchronizer
 {
 public:
     synchronizer(Handler handler, size_t clearance_count,
         const std::string& name, bool suppress_errors=false)
-      : handler_(handler),
-        clearance_count_(clearance_count),
-        name_(name),
-        counter_(std::make_shared<std::size_t>(0)),
-        counter_mutex_(std::make_shared<std::mutex>()),
-        suppress_errors_(suppress_errors)
+      : state_(std::make_shared<state>(std::move(handler), clearance_count,
+            name, suppress_errors))
     {
     }
 
     template <typename... Args>
     void operator()(const code& ec, Args... args)
     {
-        auto cleared = false;
+        auto& state = *state_;
+        const auto clearance = state.clearance_count;
+        const auto fail = ec && !state.suppress_errors;
+        auto counter = state.counter.load();
 
-        // This requires a critical section, not just an atomic counter.
-        if (true)
+        // The call that reaches clearance (or first fails) owns the handler.
+        do
         {
-            std::lock_guard<std::mutex> lock(*counter_mutex_);
-
-            BITCOIN_ASSERT(*counter_ <= clearance_count_);
-            if (*counter_ == clearance_count_)
-            {
-                //log::debug(LOG_NETWORK)
-                //    << "Synchronizing [" << name_ << "] > "
-                //    << clearance_count_ << " (ignored)";
+            BITCOIN_ASSERT(counter <= clearance);
+            if (counter == clearance)
                 return;
-            }
 
-            ++(*counter_);
+        } while (!state.counter.compare_exchange_weak(counter,
+            fail ? clearance : counter + 1));
 
-            if (ec)
-            {
-                //log::debug(LOG_NETWORK)
-                //    << "Synchronizing [" << name_ << "] " << *counter_
-                //    << "/" << clearance_count_ << " " << ec.message()
-                //    << (suppress_errors_ ? " (suppressed)" : "");
-
-                if (!suppress_errors_)
-                    *counter_ = clearance_count_;
-            }
-            else
-            {
-                //log::debug(LOG_NETWORK)
-                //    << "Synchronizing [" << name_ << "] " << *counter_ << "/"
-                //    << clearance_count_;
-            }
-
-            cleared = (*counter_ == clearance_count_);
-        }
-
-        // Use execute flag to keep this log task out of the critical section.
-        if (cleared)
+        if (fail || counter + 1 == clearance)
         {
-            const auto result = suppress_errors_ ? error::success : ec;
-            handler_(result, std::forward<Args>(args)...);
+            const auto result = state.suppress_errors ? error::success : ec;
+            state.handler(result, std::forward<Args>(args)...);
         }
     }
 
 private:
-    Handler handler_;
-    size_t clearance_count_;
-    const std::string name_;
-    const bool suppress_errors_;
+    struct state
+    {
+        state(Handler&& handler, size_t clearance_count,
+            const std::string& name, bool suppress_errors)
+          : handler(std::move(handler)),
+            clearance_count(clearance_count),
+            name(name),
+            suppress_errors(suppress_errors),
+            counter(0)
+        {
+        }
+
+        Handler handler;
+        const size_t clearance_count;
+        const std::string name;
+        const bool suppress_errors;
+        std::atomic<size_t> counter;
+    };
 
-    // We use pointer to reference the same value/mutex across instance copies.
-    std::shared_ptr<size_t> counter_;
-    std::shared_ptr<std::mutex> counter_mutex_;
+    std::shared_ptr<state> state_;
 };
 
 template <typename Handler>
 synchronizer<Handler> synchronize(Handler handler, size_t clearance_count,
     const std::string& name, bool suppress_errors=false)
 {
-    return synchronizer<Handler>(handler, clearance_count, name,
+    return synchronizer<Handler>(std::move(handler), clearance_count, name,
         suppress_errors);
 }
 
@@ -20,6 +20,7 @@
 #ifndef LIBBITCOIN_THREAD_HPP
 #define LIBBITCOIN_THREAD_HPP
 
+#include <cstddef>
 #include <bitcoin/bitcoin/define.hpp>
 
 namespace libbitcoin {
@@ -34,6 +35,10 @@ enum class thread_priority
 
 BC_API void set_thread_priority(thread_priority priority);
 
+/// Pin the calling thread to the core (modulo the number of cores).
+/// Returns false if the platform does not support thread affinity.
+BC_API bool set_thread_affinity(size_t core);
+
 } // namespace libbitcoin
 
 #endif
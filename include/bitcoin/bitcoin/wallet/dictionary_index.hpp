@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_WALLET_DICTIONARY_INDEX_HPP
+#define LIBBITCOIN_WALLET_DICTIONARY_INDEX_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/wallet/dictionary.hpp>
+
+namespace libbitcoin {
+namespace wallet {
+
+/**
+ * A sorted index over the words of a dictionary, for lookup of a word's
+ * position in logarithmic time without allocation. The dictionary must
+ * outlive the index.
+ */
+class BC_API dictionary_index
+{
+public:
+    dictionary_index(const dictionary& lexicon);
+
+    /// The indexed dictionary.
+    const dictionary& lexicon() const;
+
+    /// The position of the word in the dictionary, or -1 if not found.
+    int find(const char* word) const;
+    int find(const std::string& word) const;
+
+private:
+    typedef std::array<uint16_t, dictionary_size> position_list;
+
+    const dictionary& lexicon_;
+    position_list sorted_;
+};
+
+/**
+ * Find the position of a word in a dictionary, or -1 if not found.
+ * The built-in dictionaries are searched by index, others linearly.
+ */
+BC_API int find_word(const dictionary& lexicon, const std::string& word);
+
+} // namespace wallet
+} // namespace libbitcoin
+
+#endif
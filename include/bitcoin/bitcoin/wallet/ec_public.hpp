@@ -20,12 +20,14 @@
 #ifndef LIBBITCOIN_EC_PUBLIC_HPP
 #define LIBBITCOIN_EC_PUBLIC_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
 
 namespace libbitcoin {
 namespace wallet {
@@ -35,6 +37,7 @@ class payment_address;
 
 /// Use to pass an ec point as either ec_compressed or ec_uncompressed.
 /// ec_public doesn't carry a version for address creation or base58 encoding.
+/// Keys are trivially copyable and decode without allocation.
 class BC_API ec_public
 {
 public:
@@ -45,7 +48,6 @@ public:
 
     /// Constructors.
     ec_public();
-    ec_public(const ec_public& other);
     ec_public(const ec_private& secret);
     ec_public(const data_chunk& decoded);
     ec_public(const std::string& base16);
@@ -55,7 +57,6 @@ public:
     /// Operators.
     bool operator==(const ec_public& other) const;
     bool operator!=(const ec_public& other) const;
-    ec_public& operator=(const ec_public& other);
     friend std::istream& operator>>(std::istream& in, ec_public& to);
     friend std::ostream& operator<<(std::ostream& out, const ec_public& of);
 
@@ -99,4 +100,21 @@ private:
 } // namespace wallet
 } // namespace libbitcoin
 
+// Allow ec_public to be indexed in std::*map classes.
+namespace std
+{
+    template <>
+    struct hash<bc::wallet::ec_public>
+    {
+        size_t operator()(const bc::wallet::ec_public& key) const
+        {
+            // The x coordinate follows the sign and is well-scrambled,
+            // so just return some of that:
+            return bc::from_little_endian_unsafe<size_t>(
+                key.point().begin() + 1);
+        }
+    };
+
+} // namespace std
+
 #endif
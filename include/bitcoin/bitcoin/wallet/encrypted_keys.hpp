@@ -21,6 +21,7 @@
 #define LIBBITCOIN_ENCRYPTED_KEYS_HPP
 
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/crypto.hpp>
@@ -68,6 +69,20 @@ typedef byte_array<encrypted_token_decoded_size> encrypted_token;
 static BC_CONSTEXPR size_t ek_private_encoded_size = 58;
 static BC_CONSTEXPR size_t ek_private_decoded_size = 43;
 typedef byte_array<ek_private_decoded_size> encrypted_private;
+typedef std::vector<encrypted_private> encrypted_private_list;
+
+/**
+ * The result of decrypting an encrypted private key in a batch.
+ */
+struct BC_API ek_decrypted
+{
+    bool valid;
+    ec_secret secret;
+    uint8_t version;
+    bool compressed;
+};
+
+typedef std::vector<ek_decrypted> ek_decrypted_list;
 
 /**
  * DEPRECATED
@@ -178,6 +193,25 @@ BC_API bool decrypt(ec_secret& out_secret, uint8_t& out_version,
     bool& out_compressed, const encrypted_private& key,
     const std::string& passphrase);
 
+/**
+ * Decrypt the ec secrets associated with a batch of encrypted private keys.
+ * Keys are decrypted concurrently, each thread retaining its scrypt memory
+ * (16MB) across keys. The scrypt pass factor of ec multiplied keys is
+ * computed once for each distinct intermediate passphrase (owner salt).
+ * A failure of any thread, such as scrypt memory allocation, is rethrown on
+ * the calling thread once all threads have stopped.
+ * @param[out] out_secrets  The decrypted secrets, in order of the keys.
+ * @param[in]  keys         The encrypted private keys.
+ * @param[in]  passphrase   The passphrase common to the keys.
+ * @param[in]  threads      The number of threads, zero for hardware
+ *                          concurrency.
+ * @return false if the checksum or passphrase of any key is not valid, in
+ * which case the `valid` member of the corresponding result is false.
+ */
+BC_API bool decrypt(ek_decrypted_list& out_secrets,
+    const encrypted_private_list& keys, const std::string& passphrase,
+    size_t threads=0);
+
 /**
  * DEPRECATED
  * Decrypt the ec point associated with the encrypted public key.
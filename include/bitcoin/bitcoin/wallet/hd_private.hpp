@@ -19,8 +19,10 @@
 #ifndef LIBBITCOIN_WALLET_HD_PRIVATE_KEY_HPP
 #define LIBBITCOIN_WALLET_HD_PRIVATE_KEY_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
@@ -31,6 +33,9 @@
 namespace libbitcoin {
 namespace wallet {
 
+/// A list of extended private keys.
+typedef std::vector<hd_private> hd_private_list;
+
 /// An extended private key, as defined by BIP 32.
 class BC_API hd_private
   : public hd_public
@@ -83,6 +88,12 @@ public:
     hd_private derive_private(uint32_t index) const;
     hd_public derive_public(uint32_t index) const;
 
+    /// Derive the children [first, first + count) in order, sharing the hmac
+    /// key schedule. Invalid children are returned invalid.
+    /// Work is divided over threads, where zero implies one per core.
+    hd_private_list derive_range(uint32_t first, uint32_t count,
+        size_t threads=1) const;
+
 private:
     /// Factories.
     static hd_private from_seed(data_slice seed, uint64_t prefixes);
@@ -19,8 +19,11 @@
 #ifndef LIBBITCOIN_WALLET_HD_PUBLIC_KEY_HPP
 #define LIBBITCOIN_WALLET_HD_PUBLIC_KEY_HPP
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
@@ -52,8 +55,12 @@ struct BC_API hd_lineage
     bool operator!=(const hd_lineage& other) const;
 };
 
+class hd_public;
 class hd_private;
 
+/// A list of extended public keys.
+typedef std::vector<hd_public> hd_public_list;
+
 /// An extended public key, as defined by BIP 32.
 class BC_API hd_public
 {
@@ -97,13 +104,26 @@ public:
     hd_key to_hd_key() const;
     hd_public derive_public(uint32_t index) const;
 
+    /// Derive the children [first, first + count) in order, sharing the hmac
+    /// key schedule. Hardened or invalid children are returned invalid.
+    /// Work is divided over threads, where zero implies one per core.
+    hd_public_list derive_range(uint32_t first, uint32_t count,
+        size_t threads=1) const;
+
 protected:
+    typedef std::function<void(size_t begin, size_t end)> range_handler;
+
     /// Factories.
     static hd_public from_secret(const ec_secret& secret,
         const hd_chain_code& chain_code, const hd_lineage& lineage);
+    static hd_public from_point(const ec_compressed& point,
+        const hd_chain_code& chain_code, const hd_lineage& lineage);
 
     /// Helpers.
     uint32_t fingerprint() const;
+    static size_t range_size(uint32_t first, uint32_t count);
+    static void divide_range(size_t count, size_t threads,
+        range_handler handler);
 
     /// Members.
     /// These should be const, apart from the need to implement assignment.
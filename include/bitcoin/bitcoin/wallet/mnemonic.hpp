@@ -75,6 +75,18 @@ BC_API bool validate_mnemonic(const word_list& mnemonic,
  */
 BC_API long_hash decode_mnemonic(const word_list& mnemonic);
 
+/**
+ * Represents a list of mnemonics.
+ */
+typedef std::vector<word_list> mnemonic_list;
+
+/**
+ * Convert mnemonics with no passphrase to wallet-generation seeds, in order.
+ * The work is divided across threads, where zero implies one per core.
+ */
+BC_API long_hash_list decode_mnemonics(const mnemonic_list& mnemonics,
+    size_t threads=0);
+
 #ifdef WITH_ICU
 
 /**
@@ -84,6 +96,13 @@ BC_API long_hash decode_mnemonic(const word_list& mnemonic);
 BC_API long_hash decode_mnemonic(const word_list& mnemonic,
     const std::string& passphrase);
 
+/**
+ * Convert mnemonics sharing a passphrase to wallet-generation seeds, in order.
+ * The work is divided across threads, where zero implies one per core.
+ */
+BC_API long_hash_list decode_mnemonics(const mnemonic_list& mnemonics,
+    const std::string& passphrase, size_t threads=0);
+
 #endif
 
 } // namespace wallet
@@ -40,6 +40,7 @@ static BC_CONSTEXPR size_t payment_size = 1u + short_hash_size + checksum_size;
 typedef byte_array<payment_size> payment;
 
 /// A class for working with non-stealth payment addresses.
+/// Addresses are trivially copyable and decode without allocation.
 class BC_API payment_address
 {
 public:
@@ -57,7 +58,6 @@ public:
     payment_address(const payment& decoded);
     payment_address(const ec_private& secret);
     payment_address(const std::string& address);
-    payment_address(const payment_address& other);
     payment_address(const short_hash& hash, uint8_t version=mainnet_p2kh);
     payment_address(const ec_public& point, uint8_t version=mainnet_p2kh);
     payment_address(const chain::script& script, uint8_t version=mainnet_p2sh);
@@ -65,7 +65,6 @@ public:
     /// Operators.
     bool operator==(const payment_address& other) const;
     bool operator!=(const payment_address& other) const;
-    payment_address& operator=(const payment_address& other);
     friend std::istream& operator>>(std::istream& in, payment_address& to);
     friend std::ostream& operator<<(std::ostream& out,
         const payment_address& of);
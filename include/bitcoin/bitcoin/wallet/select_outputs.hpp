@@ -20,8 +20,11 @@
 #ifndef LIBBITCOIN_WALLET_SELECT_OUTPUTS_HPP
 #define LIBBITCOIN_WALLET_SELECT_OUTPUTS_HPP
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <map>
+#include <set>
 #include <vector>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/chain/point.hpp>
@@ -46,17 +49,103 @@ struct BC_API select_outputs_result
 
 enum class select_outputs_algorithm
 {
-    greedy
+    /// The smallest sufficient output, or else the largest outputs.
+    greedy,
+
+    /// The largest outputs, until sufficient.
+    largest_first,
+
+    /// Outputs summing to within a tolerance of the value, by search.
+    branch_and_bound,
+
+    /// Outputs with the least change, by stochastic approximation.
+    knapsack
+};
+
+/**
+ * A persistent value-sorted index of unspent outputs, for repeated selection.
+ * Insertion, removal and the selection of a single output are logarithmic.
+ */
+class BC_API output_index
+{
+public:
+    typedef std::chrono::milliseconds duration;
+
+    /// The default bound on the time spent searching.
+    static const duration default_timeout;
+
+    /// Construct an empty index.
+    output_index();
+
+    /// Add an output, false if its point is already indexed.
+    bool insert(const output_info& output);
+
+    /// Remove an output, false if its point is not indexed.
+    bool remove(const chain::output_point& point);
+
+    /// Remove each of the points, such as those of a spent selection.
+    void remove(const chain::output_point::list& points);
+
+    /// The number of indexed outputs.
+    size_t size() const;
+
+    /// The sum of the values of the indexed outputs.
+    uint64_t value() const;
+
+    /**
+     * Select outputs with a combined value of at least min_value. The
+     * searching algorithms return their best result at the timeout.
+     * Branch and bound only accepts change up to the tolerance.
+     * An empty list of points indicates that no selection was found.
+     */
+    select_outputs_result select(uint64_t min_value,
+        select_outputs_algorithm algorithm=select_outputs_algorithm::greedy,
+        uint64_t tolerance=0, const duration& timeout=default_timeout) const;
+
+private:
+    typedef std::chrono::steady_clock clock;
+
+    struct point_order
+    {
+        bool operator()(const chain::output_point& left,
+            const chain::output_point& right) const;
+    };
+
+    struct value_order
+    {
+        bool operator()(const output_info& left,
+            const output_info& right) const;
+    };
+
+    typedef std::map<chain::output_point, uint64_t, point_order> point_map;
+    typedef std::set<output_info, value_order> value_set;
+    typedef std::vector<const output_info*> candidate_list;
+
+    select_outputs_result select_greedy(uint64_t min_value) const;
+    select_outputs_result select_largest_first(uint64_t min_value) const;
+    select_outputs_result select_branch_and_bound(uint64_t min_value,
+        uint64_t tolerance, const clock::time_point& deadline) const;
+    select_outputs_result select_knapsack(uint64_t min_value,
+        const clock::time_point& deadline) const;
+
+    value_set::const_iterator lower_bound(uint64_t value) const;
+
+    point_map points_;
+    value_set values_;
+    uint64_t value_;
 };
 
 /**
  * Select optimal outputs for a send from unspent outputs list.
  * Returns output list and remaining change to be sent to
- * a change address.
+ * a change address. Branch and bound only accepts change up to the
+ * tolerance. Repeated selections from the same outputs should use an
+ * output_index.
  */
-BC_API select_outputs_result select_outputs(output_info_list unspent,
+BC_API select_outputs_result select_outputs(const output_info_list& unspent,
     uint64_t min_value,
-    select_outputs_algorithm algorithm=select_outputs_algorithm::greedy);
+    select_outputs_algorithm algorithm=select_outputs_algorithm::greedy,
+    uint64_t tolerance=0);
 
 } // namspace wallet
 } // namspace libbitcoin
@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_WALLET_STEALTH_SCANNER_HPP
+#define LIBBITCOIN_WALLET_STEALTH_SCANNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/binary.hpp>
+#include <bitcoin/bitcoin/utility/scheduler.hpp>
+#include <bitcoin/bitcoin/wallet/payment_address.hpp>
+#include <bitcoin/bitcoin/wallet/stealth_address.hpp>
+
+namespace libbitcoin {
+namespace wallet {
+
+/// The keys with which a receiver recognizes its stealth payments.
+struct BC_API stealth_scan_key
+{
+    typedef std::vector<stealth_scan_key> list;
+
+    /// The receiver's scan secret, paired with its stealth address.
+    ec_secret scan_secret;
+
+    /// The spend public key, for single key stealth addresses.
+    ec_compressed spend_key;
+
+    /// The prefix filter of the receiver's stealth address.
+    binary_type filter;
+};
+
+/// A stealth payment found by a scan.
+struct BC_API stealth_match
+{
+    typedef std::vector<stealth_match> list;
+
+    /// The position of the matching key in the scanner's key list.
+    size_t key;
+
+    /// The transaction and index of the payment output.
+    hash_digest transaction;
+    uint32_t index;
+
+    /// The ephemeral key of the sender and the uncovered payment key.
+    ec_compressed ephemeral_key;
+    ec_compressed stealth_key;
+};
+
+/**
+ * Scans blocks for stealth payments to many receivers.
+ * A payment is a null data stealth output followed by a pay key hash output.
+ * Outputs are paired with keys by prefix filter before any elliptic curve
+ * work, and the remaining shared secret computations are divided across
+ * threads. Keys are bucketed by the leading byte of their filter, so each
+ * output is only compared to the keys that it may match. The scanner is
+ * threadsafe.
+ */
+class BC_API stealth_scanner
+{
+public:
+    /// Create a key for a single spend key stealth address.
+    /// Returns false for multisignature stealth addresses.
+    static bool to_scan_key(stealth_scan_key& out_key,
+        const stealth_address& address, const ec_secret& scan_secret);
+
+    stealth_scanner(const stealth_scan_key::list& keys,
+        uint8_t p2kh_version=payment_address::mainnet_p2kh);
+
+    /// The keys in the order by which matches refer to them.
+    const stealth_scan_key::list& keys() const;
+
+    /// Find the payments to the keys in the block, in block order.
+    /// Work is divided over threads, where zero implies one per core.
+    stealth_match::list scan(const chain::block& block,
+        size_t threads=0) const;
+
+    /// Find the payments to the keys in the block, in block order.
+    /// Work is divided over the workers of the scheduler and the caller.
+    stealth_match::list scan(const chain::block& block,
+        scheduler& executor) const;
+
+private:
+    typedef std::vector<size_t> key_indexes;
+    struct scan_state;
+
+    static void match(scan_state& state, const stealth_scan_key::list& keys);
+
+    void pair(key_indexes& out_keys, uint32_t prefix) const;
+    std::shared_ptr<scan_state> prepare(const chain::block& block) const;
+    stealth_match::list emit(const scan_state& state,
+        const chain::block& block) const;
+
+    const stealth_scan_key::list keys_;
+    const uint8_t p2kh_version_;
+
+    // Keys by the leading byte of their filter, and keys with shorter filters.
+    std::vector<key_indexes> buckets_;
+    key_indexes unbucketed_;
+};
+
+} // namespace wallet
+} // namespace libbitcoin
+
+#endif
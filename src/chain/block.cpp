@@ -21,6 +21,7 @@
 
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash_context.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
@@ -139,6 +140,9 @@ hash_digest build_merkle_tree(hash_list& merkle)
     if (merkle.empty())
         return null_hash;
 
+    // The context is reset by each finalize, so it is reused for all nodes.
+    bitcoin_hash_context context;
+
     // While there is more than 1 hash in the list, keep looping...
     while (merkle.size() > 1)
     {
@@ -155,18 +159,10 @@ hash_digest build_merkle_tree(hash_list& merkle)
         // Loop through hashes 2 at a time.
         for (auto it = merkle.begin(); it != merkle.end(); it += 2)
         {
-            // Join both current hashes together (concatenate).
-            data_chunk concat_data;
-            data_sink concat_stream(concat_data);
-            ostream_writer concat_sink(concat_stream);
-            concat_sink.write_hash(*it);
-            concat_sink.write_hash(*(it + 1));
-            concat_stream.flush();
-
-            BITCOIN_ASSERT(concat_data.size() == (2 * hash_size));
-
-            // Hash both of the hashes.
-            const auto new_root = bitcoin_hash(concat_data);
+            // Hash both of the hashes, concatenated.
+            context.write_hash(*it);
+            context.write_hash(*(it + 1));
+            const auto new_root = context.finalize();
 
             // Add this to the new list.
             new_merkle.push_back(new_root);
@@ -21,6 +21,7 @@
 
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash_context.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
@@ -150,7 +151,9 @@ uint64_t header::serialized_size(bool with_transaction_count) const
 
 hash_digest header::hash() const
 {
-    return bitcoin_hash(to_data(false));
+    bitcoin_hash_context context;
+    to_data(context, false);
+    return context.finalize();
 }
 
 bool operator==(const header& left, const header& right)
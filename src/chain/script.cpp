@@ -30,6 +30,7 @@
 #include <bitcoin/bitcoin/math/script_number.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/instrument.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 #include <bitcoin/bitcoin/utility/log.hpp>
@@ -47,6 +48,9 @@ static const data_chunk stack_true_value{ 1 };
 static constexpr uint32_t five_bits = 0x0000001f;
 static constexpr uint64_t op_counter_limit = 201;
 
+BC_METRIC(evaluate_metric, "script.evaluate", histogram);
+BC_METRIC(check_signature_metric, "script.check_signature", histogram);
+
 script script::factory_from_data(const data_chunk& data, bool prefix,
     parse_mode mode)
 {
@@ -439,6 +443,8 @@ bool script::check_signature(data_slice signature, const data_chunk& point,
     const script& script_code, const transaction& parent_tx,
     uint32_t input_index)
 {
+    BC_INSTRUMENT_SCOPE(check_signature_metric);
+
     if (!is_point(point))
         return false;
 
@@ -1707,6 +1713,8 @@ bool next_step(const transaction& parent_tx, uint32_t input_index,
 bool evaluate(const transaction& parent_tx, uint32_t input_index,
     const script& script, evaluation_context& context)
 {
+    BC_INSTRUMENT_SCOPE(evaluate_metric);
+
     if (script.satoshi_content_size() > 10000)
         return false;
 
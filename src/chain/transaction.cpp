@@ -22,8 +22,10 @@
 #include <sstream>
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash_context.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/instrument.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 
@@ -32,6 +34,8 @@ namespace chain {
 
 const std::string chain::transaction::command = "tx";
 
+BC_METRIC(from_data_metric, "transaction.from_data", histogram);
+
 transaction transaction::factory_from_data(const data_chunk& data)
 {
     transaction instance;
@@ -81,6 +85,7 @@ bool transaction::from_data(std::istream& stream)
 
 bool transaction::from_data(reader& source)
 {
+    BC_INSTRUMENT_SCOPE(from_data_metric);
     reset();
     version = source.read_4_bytes_little_endian();
     auto result = static_cast<bool>(source);
@@ -187,14 +192,17 @@ std::string transaction::to_string() const
 
 hash_digest transaction::hash() const
 {
-    return bitcoin_hash(to_data());
+    bitcoin_hash_context context;
+    to_data(context);
+    return context.finalize();
 }
 
 hash_digest transaction::hash(uint32_t hash_type_code) const
 {
-    data_chunk serialized = to_data();
-    extend_data(serialized, to_little_endian(hash_type_code));
-    return bitcoin_hash(serialized);
+    bitcoin_hash_context context;
+    to_data(context);
+    context.write_4_bytes_little_endian(hash_type_code);
+    return context.finalize();
 }
 
 bool transaction::is_coinbase() const
@@ -20,50 +20,107 @@
 #include <bitcoin/bitcoin/formats/base16.hpp>
 
 #include <algorithm>
-#include <iomanip>
-#include <sstream>
-#include <boost/algorithm/string.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
 #include <bitcoin/bitcoin/utility/data.hpp>
 
 namespace libbitcoin {
 
-std::string encode_base16(data_slice data)
+static const char base16_digits[] = "0123456789abcdef";
+
+// The value of each character as a hex digit, or -1 if it is not one.
+// This is constant initialized, so it is safe to use during static
+// initialization, where literals are commonly decoded.
+static const int8_t base16_values[256] =
+{
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+static inline int8_t from_hex(const char c)
 {
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0');
-    for (int val: data)
-        ss << std::setw(2) << val;
-    return ss.str();
+    return base16_values[static_cast<uint8_t>(c)];
 }
 
 bool is_base16(const char c)
 {
-    return
-        ('0' <= c && c <= '9') ||
-        ('A' <= c && c <= 'F') ||
-        ('a' <= c && c <= 'f');
+    return from_hex(c) >= 0;
 }
 
-static unsigned from_hex(const char c)
+static bool is_base16(const char* in, size_t size)
 {
-    if ('A' <= c && c <= 'F')
-        return 10 + c - 'A';
-    if ('a' <= c && c <= 'f')
-        return 10 + c - 'a';
-    return c - '0';
+    // Accumulate the sign bits to avoid a branch per character.
+    int8_t invalid = 0;
+    for (size_t index = 0; index < size; ++index)
+        invalid |= from_hex(in[index]);
+
+    return invalid >= 0;
 }
 
-bool decode_base16(data_chunk& out, const std::string& in)
+// The input must be valid base16 of twice the output size.
+static void decode_valid(uint8_t* out, size_t out_size, const char* in)
 {
-    // This prevents a last odd character from being ignored:
-    if (in.size() % 2 != 0)
+    for (size_t index = 0; index < out_size; ++index, in += 2)
+        out[index] = static_cast<uint8_t>((from_hex(in[0]) << 4) |
+            from_hex(in[1]));
+}
+
+void encode_base16(char* out, data_slice data)
+{
+    for (const auto byte: data)
+    {
+        *out++ = base16_digits[byte >> 4];
+        *out++ = base16_digits[byte & 0x0f];
+    }
+}
+
+void encode_base16(std::string& out, data_slice data)
+{
+    out.resize(2 * data.size());
+    if (!out.empty())
+        encode_base16(&out.front(), data);
+}
+
+std::string encode_base16(data_slice data)
+{
+    std::string out;
+    encode_base16(out, data);
+    return out;
+}
+
+bool decode_base16(uint8_t* out, size_t out_size, const char* in,
+    size_t in_size)
+{
+    if (in_size != 2 * out_size || !is_base16(in, in_size))
         return false;
 
-    data_chunk result(in.size() / 2);
-    if (!decode_base16_private(result.data(), result.size(), in.data()))
+    decode_valid(out, out_size, in);
+    return true;
+}
+
+bool decode_base16(data_chunk& out, const std::string& in)
+{
+    // This prevents a last odd character from being ignored:
+    if (in.size() % 2 != 0 || !is_base16(in.data(), in.size()))
         return false;
 
-    out = result;
+    out.resize(in.size() / 2);
+    decode_valid(out.data(), out.size(), in.data());
     return true;
 }
 
@@ -76,15 +133,13 @@ std::string encode_hash(hash_digest hash)
 
 bool decode_hash(hash_digest& out, const std::string& in)
 {
-    if (in.size() != 2 * hash_size)
+    if (in.size() != 2 * hash_size || !is_base16(in.data(), in.size()))
         return false;
 
-    hash_digest result;
-    if (!decode_base16_private(result.data(), result.size(), in.data()))
-        return false;
+    decode_valid(out.data(), out.size(), in.data());
 
     // Reverse:
-    std::reverse_copy(result.begin(), result.end(), out.begin());
+    std::reverse(out.begin(), out.end());
     return true;
 }
 
@@ -101,15 +156,10 @@ hash_digest hash_literal(const char (&string)[2 * hash_size + 1])
 // For support of template implementation only, do not call directly.
 bool decode_base16_private(uint8_t* out, size_t out_size, const char* in)
 {
-    if (!std::all_of(in, in + 2 * out_size, is_base16))
+    if (!is_base16(in, 2 * out_size))
         return false;
 
-    for (size_t i = 0; i < out_size; ++i)
-    {
-        out[i] = (from_hex(in[0]) << 4) + from_hex(in[1]);
-        in += 2;
-    }
-
+    decode_valid(out, out_size, in);
     return true;
 }
 
@@ -19,18 +19,63 @@
  */
 #include <bitcoin/bitcoin/formats/base58.hpp>
 
-#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin/compat.hpp>
+#include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/string.hpp>
 
 namespace libbitcoin {
 
 const std::string base58_chars =
     "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
 
+// The value of each character as a base58 digit, or -1 if it is not one.
+// This is constant initialized, so it is safe to use during static
+// initialization, where literals are commonly decoded.
+static const int8_t base58_values[256] =
+{
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1,  0,  1,  2,  3,  4,  5,  6,  7,  8, -1, -1, -1, -1, -1, -1,
+    -1,  9, 10, 11, 12, 13, 14, 15, 16, -1, 17, 18, 19, 20, 21, -1,
+    22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, -1, -1, -1, -1, -1,
+    -1, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, -1, 44, 45, 46,
+    47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+// Numbers are held in 32 bit limbs, least significant first. Encoding
+// uses limbs of five base58 digits, consuming four bytes at a time, and
+// decoding uses limbs of four bytes, consuming five digits at a time.
+// Either way the product of a limb and a multiplier fits in 64 bits.
+static BC_CONSTEXPR uint64_t base58_limb_radix = 656356768;
+static BC_CONSTEXPR uint64_t byte_limb_radix = 4294967296;
+static BC_CONSTEXPR size_t base58_limb_digits = 5;
+static BC_CONSTEXPR size_t byte_limb_size = 4;
+
+typedef std::vector<uint32_t> limb_list;
+
 bool is_base58(const char ch)
 {
-    // This works because the base58 characters happen to be in sorted order
-    return std::binary_search(base58_chars.begin(), base58_chars.end(), ch);
+    return base58_values[static_cast<uint8_t>(ch)] >= 0;
 }
 
 bool is_base58(const std::string& text)
@@ -43,154 +88,309 @@ bool is_base58(const std::string& text)
     return std::all_of(text.begin(), text.end(), test);
 }
 
-template <typename Data>
-auto search_first_nonzero(const Data& data) -> decltype(data.cbegin())
+// Apply "limbs = limbs * multiplier + addend" in the given radix.
+// Returns false if the result does not fit within capacity limbs.
+template <uint64_t Radix>
+static bool multiply_add(uint32_t* limbs, size_t capacity, size_t& used,
+    uint64_t multiplier, uint64_t addend)
 {
-    auto first_nonzero = data.cbegin();
-    while (first_nonzero != data.end() && *first_nonzero == 0)
-        ++first_nonzero;
+    auto carry = addend;
+    for (size_t index = 0; index < used; ++index)
+    {
+        const auto value = limbs[index] * multiplier + carry;
+        limbs[index] = static_cast<uint32_t>(value % Radix);
+        carry = value / Radix;
+    }
 
-    return first_nonzero;
+    while (carry != 0)
+    {
+        if (used == capacity)
+            return false;
+
+        limbs[used++] = static_cast<uint32_t>(carry % Radix);
+        carry /= Radix;
+    }
+
+    return true;
 }
 
-size_t count_leading_zeros(data_slice unencoded)
+// The payload is the concatenation of the data and the suffix, which allows
+// a checksum to be encoded without copying the data.
+static void encode(std::string& out, data_slice data, data_slice suffix,
+    limb_list& limbs)
 {
-    // Skip and count leading '1's.
-    size_t leading_zeros = 0;
-    for (const uint8_t byte: unencoded)
+    const auto size = data.size() + suffix.size();
+    const auto byte = [&data, &suffix](size_t position)
     {
-        if (byte != 0)
-            break;
+        return position < data.size() ? data.data()[position] :
+            suffix.data()[position - data.size()];
+    };
 
-        ++leading_zeros;
+    size_t zeros = 0;
+    while (zeros < size && byte(zeros) == 0)
+        ++zeros;
+
+    // log(256) / log(58), rounded up.
+    const auto digits = (size - zeros) * 138 / 100 + 1;
+    limbs.resize(digits / base58_limb_digits + 1);
+    size_t used = 0;
+
+    // The leading bytes that do not fill a word are consumed first.
+    auto position = zeros;
+    auto bytes = (size - zeros) % byte_limb_size;
+    if (bytes == 0)
+        bytes = byte_limb_size;
+
+    while (position < size)
+    {
+        uint64_t word = 0;
+        for (size_t count = 0; count < bytes; ++count)
+            word = (word << 8) | byte(position++);
+
+        const auto multiplier = uint64_t(1) << (8 * bytes);
+        if (!multiply_add<base58_limb_radix>(limbs.data(), limbs.size(),
+            used, multiplier, word))
+            throw std::overflow_error("base58 limb capacity exceeded");
+
+        bytes = byte_limb_size;
     }
 
-    return leading_zeros;
-}
+    out.assign(zeros, base58_chars[0]);
 
-void pack_value(data_chunk& indexes, size_t carry)
-{
-    // Apply "b58 = b58 * 256 + ch".
-    for (auto it = indexes.rbegin(); it != indexes.rend(); ++it)
+    char buffer[base58_limb_digits];
+    for (auto limb = used; limb-- > 0;)
     {
-        carry += 256 * (*it);
-        *it = carry % 58;
-        carry /= 58;
+        auto value = limbs[limb];
+        for (auto digit = base58_limb_digits; digit-- > 0;)
+        {
+            buffer[digit] = base58_chars[value % 58];
+            value /= 58;
+        }
+
+        // Only the most significant limb has leading zero digits to skip.
+        size_t first = 0;
+        if (limb + 1 == used)
+            while (buffer[first] == base58_chars[0])
+                ++first;
+
+        out.append(buffer + first, buffer + base58_limb_digits);
     }
+}
 
-    BITCOIN_ASSERT(carry == 0);
+// The number of leading zero digits, which decode to zero bytes.
+static size_t leading_zeros(const char* in, size_t size)
+{
+    size_t zeros = 0;
+    while (zeros < size && in[zeros] == base58_chars[0])
+        ++zeros;
+
+    return zeros;
 }
 
-std::string encode_base58(data_slice unencoded)
+// The number of limbs sufficient to decode the given number of digits.
+static size_t decode_limbs(size_t digits)
 {
-    size_t leading_zeros = count_leading_zeros(unencoded);
+    // log(58) / log(256), rounded up.
+    const auto bytes = digits * 733 / 1000 + 1;
+    return bytes / byte_limb_size + 1;
+}
 
-    // size = log(256) / log(58), rounded up.
-    const size_t number_nonzero = unencoded.size() - leading_zeros;
-    const size_t indexes_size = number_nonzero * 138 / 100 + 1;
+// Decode the digits following the zeros into limbs of sufficient capacity.
+static bool decode(uint32_t* limbs, size_t capacity, size_t& used,
+    const char* in, size_t size, size_t zeros)
+{
+    used = 0;
 
-    // Allocate enough space in big-endian base58 representation.
-    data_chunk indexes(indexes_size);
+    // The leading digits that do not fill a limb are consumed first.
+    auto position = zeros;
+    auto digits = (size - zeros) % base58_limb_digits;
+    if (digits == 0)
+        digits = base58_limb_digits;
 
-    // Process the bytes.
-    for (auto it = unencoded.begin() + leading_zeros;
-        it != unencoded.end(); ++it)
+    while (position < size)
     {
-        pack_value(indexes, *it);
+        uint64_t value = 0;
+        uint64_t multiplier = 1;
+        for (size_t count = 0; count < digits; ++count)
+        {
+            const auto digit = base58_values[
+                static_cast<uint8_t>(in[position++])];
+
+            if (digit < 0)
+                return false;
+
+            value = value * 58 + digit;
+            multiplier *= 58;
+        }
+
+        if (!multiply_add<byte_limb_radix>(limbs, capacity, used,
+            multiplier, value))
+            return false;
+
+        digits = base58_limb_digits;
     }
 
-    // Skip leading zeroes in base58 result.
-    auto first_nonzero = search_first_nonzero(indexes);
+    return true;
+}
 
-    // Translate the result into a string.
-    std::string encoded;
-    const size_t estimated_size = leading_zeros + 
-        (indexes.end() - first_nonzero);
-    encoded.reserve(estimated_size);
-    encoded.assign(leading_zeros, '1');
+static bool decode(limb_list& limbs, size_t& used, size_t& zeros,
+    const std::string& in)
+{
+    zeros = leading_zeros(in.data(), in.size());
+    limbs.resize(decode_limbs(in.size() - zeros));
+    return decode(limbs.data(), limbs.size(), used, in.data(), in.size(),
+        zeros);
+}
 
-    // Set actual main bytes.
-    for (auto it = first_nonzero; it != indexes.end(); ++it)
-    {
-        const size_t index = *it;
-        encoded += base58_chars[index];
-    }
+// The number of significant bytes in the decoded number.
+static size_t decoded_size(const uint32_t* limbs, size_t used, size_t zeros)
+{
+    if (used == 0)
+        return zeros;
 
-    return encoded;
+    auto top = limbs[used - 1];
+    size_t bytes = 0;
+    for (; top != 0; top >>= 8)
+        ++bytes;
+
+    return zeros + bytes + (used - 1) * byte_limb_size;
 }
 
-size_t count_leading_zeros(const std::string& encoded)
+// The output must be of the decoded size.
+static void write(uint8_t* out, const uint32_t* limbs, size_t used,
+    size_t zeros, size_t size)
 {
-    // Skip and count leading '1's.
-    size_t leading_zeros = 0;
-    for (const uint8_t digit: encoded)
+    std::fill(out, out + zeros, 0x00);
+
+    // Lower limbs are written in full, the top limb without leading zeros.
+    auto position = size;
+    for (size_t limb = 0; limb < used; ++limb)
     {
-        if (digit != base58_chars[0])
-            break;
+        const auto bytes = limb + 1 < used ? byte_limb_size :
+            size - zeros - (used - 1) * byte_limb_size;
 
-        ++leading_zeros;
+        auto value = limbs[limb];
+        for (size_t count = 0; count < bytes; ++count, value >>= 8)
+            out[--position] = static_cast<uint8_t>(value);
     }
+}
 
-    return leading_zeros;
+std::string encode_base58(data_slice unencoded)
+{
+    static const data_chunk no_suffix;
+    limb_list limbs;
+    std::string encoded;
+    encode(encoded, unencoded, no_suffix, limbs);
+    return encoded;
 }
 
-void unpack_char(data_chunk& data, size_t carry)
+bool decode_base58(data_chunk& out, const std::string& in)
 {
-    for (auto it = data.rbegin(); it != data.rend(); it++)
-    {
-        carry += 58 * (*it);
-        *it = carry % 256;
-        carry /= 256;
-    }
+    size_t used;
+    size_t zeros;
+    limb_list limbs;
+    if (!decode(limbs, used, zeros, in))
+        return false;
 
-    BITCOIN_ASSERT(carry == 0);
+    const auto size = decoded_size(limbs.data(), used, zeros);
+    out.resize(size);
+    write(out.data(), limbs.data(), used, zeros, size);
+    return true;
 }
 
-bool decode_base58(data_chunk& out, const std::string& in)
+static void encode_check(std::string& out, data_slice unencoded,
+    limb_list& limbs)
 {
-    // Trim spaces and newlines around the string.
-    const auto leading_zeros = count_leading_zeros(in);
+    const auto checksum = to_little_endian(bitcoin_checksum(unencoded));
+    encode(out, unencoded, checksum, limbs);
+}
 
-    // log(58) / log(256), rounded up.
-    const size_t data_size = in.size() * 733 / 1000 + 1;
+static bool decode_check(data_chunk& out, const std::string& in,
+    limb_list& limbs, data_chunk& buffer)
+{
+    size_t used;
+    size_t zeros;
+    if (!decode(limbs, used, zeros, in))
+        return false;
 
-    // Allocate enough space in big-endian base256 representation.
-    data_chunk data(data_size);
+    const auto size = decoded_size(limbs.data(), used, zeros);
+    if (size < checksum_size)
+        return false;
 
-    // Process the characters.
-    for (auto it = in.begin() + leading_zeros; it != in.end(); ++it)
-    {
-        const auto carry = base58_chars.find(*it);
-        if (carry == std::string::npos)
-            return false;
+    buffer.resize(size);
+    write(buffer.data(), limbs.data(), used, zeros, size);
+    if (!verify_checksum(buffer))
+        return false;
 
-        unpack_char(data, carry);
-    }
+    out.assign(buffer.begin(), buffer.end() - checksum_size);
+    return true;
+}
 
-    // Skip leading zeroes in data.
-    auto first_nonzero = search_first_nonzero(data);
+std::string encode_base58_check(data_slice unencoded)
+{
+    limb_list limbs;
+    std::string encoded;
+    encode_check(encoded, unencoded, limbs);
+    return encoded;
+}
+
+bool decode_base58_check(data_chunk& out, const std::string& in)
+{
+    limb_list limbs;
+    data_chunk buffer;
+    return decode_check(out, in, limbs, buffer);
+}
+
+string_list encode_base58_check(const data_stack& unencoded)
+{
+    limb_list limbs;
+    string_list encoded(unencoded.size());
+    for (size_t index = 0; index < unencoded.size(); ++index)
+        encode_check(encoded[index], unencoded[index], limbs);
 
-    // Copy result into output vector.
-    data_chunk decoded;
-    const size_t estimated_size = leading_zeros + (data.end() - first_nonzero);
-    decoded.reserve(estimated_size);
-    decoded.assign(leading_zeros, 0x00);
-    decoded.insert(decoded.end(), first_nonzero, data.cend());
+    return encoded;
+}
+
+bool decode_base58_check(data_stack& out, const string_list& in)
+{
+    limb_list limbs;
+    data_chunk buffer;
+    data_stack decoded(in.size());
+    for (size_t index = 0; index < in.size(); ++index)
+        if (!decode_check(decoded[index], in[index], limbs, buffer))
+            return false;
 
-    out = decoded;
+    out.swap(decoded);
     return true;
 }
 
+// Fixed size outputs such as addresses and keys are decoded on the stack.
+static BC_CONSTEXPR size_t stack_limbs = 32;
+
 // For support of template implementation only, do not call directly.
 bool decode_base58_private(uint8_t* out, size_t out_size, const char* in)
 {
-    data_chunk buffer;
-    if (!decode_base58(buffer, in) || buffer.size() != out_size)
+    const auto size = std::strlen(in);
+    const auto zeros = leading_zeros(in, size);
+    const auto digits = size - zeros;
+
+    // Each digit after the first adds more than 0.732 bytes, so a longer
+    // input cannot decode to the output size (and would overflow the stack).
+    if (zeros > out_size || (digits > 0 && (digits - 1) * 732 / 1000 >
+        out_size))
         return false;
 
-    for (size_t i = 0; i < out_size; ++i)
-        out[i] = buffer[i];
+    const auto capacity = decode_limbs(digits);
+    std::array<uint32_t, stack_limbs> stack;
+    limb_list heap(capacity > stack_limbs ? capacity : 0);
+    const auto limbs = heap.empty() ? stack.data() : heap.data();
+
+    size_t used;
+    if (!decode(limbs, capacity, used, in, size, zeros) ||
+        decoded_size(limbs, used, zeros) != out_size)
+        return false;
 
+    write(out, limbs, used, zeros, out_size);
     return true;
 }
 
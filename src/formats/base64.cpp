@@ -19,7 +19,10 @@
  */
 #include <bitcoin/bitcoin/formats/base64.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <istream>
+#include <ostream>
 #include <string>
 #include <bitcoin/bitcoin/utility/data.hpp>
 
@@ -33,120 +36,186 @@ const static char pad = '=';
 const static char table[] = 
     "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-std::string encode_base64(data_slice unencoded)
+// The value of each character as a base64 digit, or -1 if it is not one.
+const static int8_t values[256] =
+{
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+    -1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+    -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+// Streams are transcoded in chunks of this many groups.
+static const size_t stream_groups = 1024;
+
+static size_t encoded_size(size_t size)
 {
-    std::string encoded;
-    const auto size = unencoded.size();
-    encoded.reserve(((size / 3) + (size % 3 > 0)) * 4);
+    return (size + 2) / 3 * 4;
+}
 
-    uint32_t value;
-    auto cursor = unencoded.begin();
-    for (size_t position = 0; position < size / 3; position++)
+// Write the encoding of the input, with padding, to the output.
+static void encode(char* out, const uint8_t* in, size_t size)
+{
+    const auto end = in + size - size % 3;
+    for (; in != end; in += 3)
     {
         // Convert to big endian.
-        value = (*cursor++) << 16;
-
-        value += (*cursor++) << 8;
-        value += (*cursor++);
-        encoded.append(1, table[(value & 0x00FC0000) >> 18]);
-        encoded.append(1, table[(value & 0x0003F000) >> 12]);
-        encoded.append(1, table[(value & 0x00000FC0) >> 6]);
-        encoded.append(1, table[(value & 0x0000003F) >> 0]);
+        const uint32_t value = (in[0] << 16) | (in[1] << 8) | in[2];
+        *out++ = table[(value >> 18) & 0x3f];
+        *out++ = table[(value >> 12) & 0x3f];
+        *out++ = table[(value >> 6) & 0x3f];
+        *out++ = table[value & 0x3f];
     }
 
     switch (size % 3)
     {
         case 1:
-            // Convert to big endian.
-            value = (*cursor++) << 16;
-
-            encoded.append(1, table[(value & 0x00FC0000) >> 18]);
-            encoded.append(1, table[(value & 0x0003F000) >> 12]);
-            encoded.append(2, pad);
+        {
+            const uint32_t value = in[0] << 16;
+            *out++ = table[(value >> 18) & 0x3f];
+            *out++ = table[(value >> 12) & 0x3f];
+            *out++ = pad;
+            *out++ = pad;
             break;
+        }
         case 2:
-            // Convert to big endian.
-            value = (*cursor++) << 16;
-
-            value += (*cursor++) << 8;
-            encoded.append(1, table[(value & 0x00FC0000) >> 18]);
-            encoded.append(1, table[(value & 0x0003F000) >> 12]);
-            encoded.append(1, table[(value & 0x00000FC0) >> 6]);
-            encoded.append(1, pad);
+        {
+            const uint32_t value = (in[0] << 16) | (in[1] << 8);
+            *out++ = table[(value >> 18) & 0x3f];
+            *out++ = table[(value >> 12) & 0x3f];
+            *out++ = table[(value >> 6) & 0x3f];
+            *out++ = pad;
             break;
+        }
+    }
+}
+
+static size_t padding(const char* in, size_t size)
+{
+    if (size == 0 || in[size - 1] != pad)
+        return 0;
+
+    return in[size - 2] == pad ? 2 : 1;
+}
+
+// The input size must be a multiple of four, and padding may only end it.
+// The output must have room for three bytes per four characters.
+static bool decode(uint8_t* out, size_t& out_size, const char* in,
+    size_t size)
+{
+    const auto padded = padding(in, size);
+    const auto start = out;
+    const auto end = in + size;
+
+    for (; in != end; in += 4)
+    {
+        const auto last = (in + 4 == end);
+        const auto digits = last ? 4 - padded : 4;
+
+        // Accumulate the sign bits to avoid a branch per character.
+        int8_t invalid = 0;
+        uint32_t value = 0;
+        for (size_t digit = 0; digit < 4; ++digit)
+        {
+            const auto number = digit < digits ?
+                values[static_cast<uint8_t>(in[digit])] : 0;
+
+            invalid |= number;
+            value = (value << 6) | (number & 0x3f);
+        }
+
+        if (invalid < 0)
+            return false;
+
+        *out++ = static_cast<uint8_t>(value >> 16);
+        if (digits > 2)
+            *out++ = static_cast<uint8_t>(value >> 8);
+        if (digits > 3)
+            *out++ = static_cast<uint8_t>(value);
     }
 
+    out_size = out - start;
+    return true;
+}
+
+std::string encode_base64(data_slice unencoded)
+{
+    std::string encoded(encoded_size(unencoded.size()), pad);
+    if (!encoded.empty())
+        encode(&encoded.front(), unencoded.data(), unencoded.size());
+
     return encoded;
 }
 
 bool decode_base64(data_chunk& out, const std::string& in)
 {
-    const static uint32_t mask = 0x000000FF;
-
     const auto length = in.length();
     if ((length % 4) != 0)
         return false;
 
-    size_t padding = 0;
-    if (length > 0)
+    size_t size;
+    data_chunk decoded(length / 4 * 3);
+    if (!decode(decoded.data(), size, in.data(), length))
+        return false;
+
+    decoded.resize(size);
+    out.swap(decoded);
+    return true;
+}
+
+bool encode_base64(std::ostream& out, std::istream& in)
+{
+    uint8_t bytes[stream_groups * 3];
+    char characters[stream_groups * 4];
+
+    while (in)
     {
-        if (in[length - 1] == pad)
-            padding++;
-        if (in[length - 2] == pad)
-            padding++;
+        // A short read only occurs at the end of the input.
+        in.read(reinterpret_cast<char*>(bytes), sizeof(bytes));
+        const auto size = static_cast<size_t>(in.gcount());
+        encode(characters, bytes, size);
+        out.write(characters, encoded_size(size));
     }
 
-    data_chunk decoded;
-    decoded.reserve(((length / 4) * 3) - padding);
+    return !in.bad() && !out.fail();
+}
+
+bool decode_base64(std::ostream& out, std::istream& in)
+{
+    char characters[stream_groups * 4];
+    uint8_t bytes[stream_groups * 3];
+    auto padded = false;
 
-    uint32_t value = 0;
-    for (auto cursor = in.begin(); cursor < in.end();)
+    while (in)
     {
-        for (size_t position = 0; position < 4; position++)
-        {
-            value <<= 6;
-            if (*cursor >= 0x41 && *cursor <= 0x5A)
-                value |= *cursor - 0x41;
-            else if (*cursor >= 0x61 && *cursor <= 0x7A)
-                value |= *cursor - 0x47;
-            else if (*cursor >= 0x30 && *cursor <= 0x39)
-                value |= *cursor + 0x04;
-            else if (*cursor == 0x2B)
-                value |= 0x3E;
-            else if (*cursor == 0x2F)
-                value |= 0x3F;
-            else if (*cursor == pad)
-            {
-                // Handle 1 or 2 pad characters.
-                switch (in.end() - cursor)
-                {
-                    case 1:
-                        decoded.push_back((value >> 16) & mask);
-                        decoded.push_back((value >> 8) & mask);
-                        out = decoded;
-                        return true;
-                    case 2:
-                        decoded.push_back((value >> 10) & mask);
-                        out = decoded;
-                        return true;
-                    default:
-                        return false;
-                }
-            }
-            else
-                return false;
-
-            cursor++;
-        }
+        in.read(characters, sizeof(characters));
+        const auto length = static_cast<size_t>(in.gcount());
+        if (length == 0)
+            break;
 
-        decoded.push_back((value >> 16) & mask);
-        decoded.push_back((value >> 8) & mask);
-        decoded.push_back((value >> 0) & mask);
+        // Padding may only occur at the end of the input.
+        size_t size;
+        if (padded || (length % 4) != 0 ||
+            !decode(bytes, size, characters, length))
+            return false;
+
+        padded = padding(characters, length) != 0;
+        out.write(reinterpret_cast<const char*>(bytes), size);
     }
 
-    out = decoded;
-    return true;
+    return !in.bad() && !out.fail();
 }
 
 } // namespace libbitcoin
-
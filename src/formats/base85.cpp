@@ -51,7 +51,10 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <istream>
+#include <ostream>
 #include <string>
+#include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 
@@ -71,9 +74,14 @@ static char encoder[85 + 1] =
     "}@%$#"
 };
 
-// Maps base 85 to binary.
-static uint8_t decoder[96] =
+// Maps base 85 to binary, indexed by character.
+// Control and non-ascii characters are invalid (0xFF).
+static const uint8_t decoder[256] =
 {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
     0x00, 0x44, 0x00, 0x54, 0x53, 0x52, 0x48, 0x00,
     0x4B, 0x4C, 0x46, 0x41, 0x00, 0x3F, 0x3E, 0x45,
     0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
@@ -85,36 +93,86 @@ static uint8_t decoder[96] =
     0x00, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10,
     0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
     0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20,
-    0x21, 0x22, 0x23, 0x4F, 0x00, 0x50, 0x00, 0x00
+    0x21, 0x22, 0x23, 0x4F, 0x00, 0x50, 0x00, 0x00,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
 };
 
-// Accepts only byte arrays bounded to 4 bytes.
-bool encode_base85(std::string& out, data_slice in)
+static BC_CONSTEXPR uint8_t invalid = 0xFF;
+
+// Streams are transcoded in chunks of this many groups.
+static const size_t stream_groups = 1024;
+
+// The input size must be a multiple of four.
+static void encode(char* out, const uint8_t* in, size_t size)
 {
-    const size_t size = in.size();
-    if (size % 4 != 0)
-        return false;
+    for (const auto end = in + size; in != end; in += 4)
+    {
+        // Convert to big endian.
+        auto value = (uint32_t(in[0]) << 24) | (uint32_t(in[1]) << 16) |
+            (uint32_t(in[2]) << 8) | uint32_t(in[3]);
 
-    const size_t encoded_size = size * 5 / 4;
-    std::string encoded;
-    encoded.reserve(encoded_size + 1);
-    size_t byte_index = 0;
-    uint32_t accumulator = 0;
+        // Write the digits from least significant.
+        for (auto digit = 5; digit-- > 0; value /= 85)
+            out[digit] = encoder[value % 85];
+
+        out += 5;
+    }
+}
 
-    for (const uint8_t unencoded_byte: in)
+// The input size must be a multiple of five.
+// Printable characters outside of the alphabet have the value zero, as in
+// the reference implementation.
+static bool decode(uint8_t* out, const char* in, size_t size)
+{
+    for (const auto end = in + size; in != end; in += 5)
     {
-        accumulator = accumulator * 256 + unencoded_byte;
-        if (++byte_index % 4 == 0)
+        uint32_t value = 0;
+        for (size_t digit = 0; digit < 5; ++digit)
         {
-            for (uint32_t divise = 85 * 85 * 85 * 85; divise > 0; divise /= 85)
-                encoded.push_back(encoder[accumulator / divise % 85]);
+            const auto digit_value = decoder[static_cast<uint8_t>(in[digit])];
+            if (digit_value == invalid)
+                return false;
 
-            accumulator = 0;
+            value = value * 85 + digit_value;
         }
+
+        // Convert from big endian.
+        *out++ = static_cast<uint8_t>(value >> 24);
+        *out++ = static_cast<uint8_t>(value >> 16);
+        *out++ = static_cast<uint8_t>(value >> 8);
+        *out++ = static_cast<uint8_t>(value);
     }
 
-    out.assign(encoded.begin(), encoded.end());
-    BITCOIN_ASSERT(out.size() == encoded_size);
+    return true;
+}
+
+// Accepts only byte arrays bounded to 4 bytes.
+bool encode_base85(std::string& out, data_slice in)
+{
+    const size_t size = in.size();
+    if (size % 4 != 0)
+        return false;
+
+    const size_t encoded_size = size * 5 / 4;
+    out.resize(encoded_size);
+    if (!out.empty())
+        encode(&out.front(), in.data(), size);
+
     return true;
 }
 
@@ -126,30 +184,51 @@ bool decode_base85(data_chunk& out, const std::string& in)
         return false;
 
     const size_t decoded_size = length * 4 / 5;
-    data_chunk decoded;
-    decoded.reserve(decoded_size);
-    size_t char_index = 0;
-    uint32_t accumulator = 0;
+    data_chunk decoded(decoded_size);
+    if (!decode(decoded.data(), in.data(), length))
+        return false;
 
-    for (const uint8_t encoded_character: in)
+    out.swap(decoded);
+    return true;
+}
+
+bool encode_base85(std::ostream& out, std::istream& in)
+{
+    uint8_t bytes[stream_groups * 4];
+    char characters[stream_groups * 5];
+
+    while (in)
     {
-        const auto position = encoded_character - 32;
-        if (position < 0 || position > 96)
+        // A short read only occurs at the end of the input.
+        in.read(reinterpret_cast<char*>(bytes), sizeof(bytes));
+        const auto size = static_cast<size_t>(in.gcount());
+        if (size % 4 != 0)
             return false;
 
-        accumulator = accumulator * 85 + decoder[position];
-        if (++char_index % 5 == 0)
-        {
-            for (uint32_t divise = 256 * 256 * 256; divise > 0; divise /= 256)
-                decoded.push_back(accumulator / divise % 256);
+        encode(characters, bytes, size);
+        out.write(characters, size * 5 / 4);
+    }
 
-            accumulator = 0;
-        }
+    return !in.bad() && !out.fail();
+}
+
+bool decode_base85(std::ostream& out, std::istream& in)
+{
+    char characters[stream_groups * 5];
+    uint8_t bytes[stream_groups * 4];
+
+    while (in)
+    {
+        // A short read only occurs at the end of the input.
+        in.read(characters, sizeof(characters));
+        const auto length = static_cast<size_t>(in.gcount());
+        if (length % 5 != 0 || !decode(bytes, characters, length))
+            return false;
+
+        out.write(reinterpret_cast<const char*>(bytes), length * 4 / 5);
     }
 
-    out.assign(decoded.begin(), decoded.end());
-    BITCOIN_ASSERT(out.size() == decoded_size);
-    return true;
+    return !in.bad() && !out.fail();
 }
 
 } // namespace libbitcoin
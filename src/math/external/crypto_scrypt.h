@@ -50,6 +50,32 @@ int crypto_scrypt(const uint8_t* passphrase, size_t passphrase_length,
     const uint8_t* salt, size_t salt_length, uint64_t N, uint32_t r,
     uint32_t p, uint8_t* buf, size_t buf_length);
 
+/**
+ * crypto_scrypt_check(N, r, p, buflen):
+ * Return 0 if the parameters are acceptable to crypto_scrypt; or set errno
+ * and return -1 otherwise.  N = 1 is rejected (EINVAL), as smix computes
+ * the blocks in pairs.
+ */
+int crypto_scrypt_check(uint64_t N, uint32_t r, uint32_t p,
+    size_t buf_length);
+
+/**
+ * crypto_scrypt_scratch_size(N, r):
+ * Return the size of the working memory required by crypto_scrypt_smix for
+ * the (checked) parameters N and r, including alignment padding.
+ */
+size_t crypto_scrypt_scratch_size(uint64_t N, uint32_t r);
+
+/**
+ * crypto_scrypt_smix(B, r, N, scratch):
+ * Compute B = SMix_r(B, N) for one of the p independent lanes of 128r bytes.
+ * The scratch must be crypto_scrypt_scratch_size(N, r) bytes, and may be
+ * reused across calls.  Distinct lanes may be computed concurrently, each
+ * with its own scratch.
+ */
+void crypto_scrypt_smix(uint8_t* B, uint32_t r, uint64_t N,
+    uint8_t* scratch);
+
 #ifdef __cplusplus
 }
 #endif
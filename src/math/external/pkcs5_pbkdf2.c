@@ -18,63 +18,101 @@
 
 #include <stddef.h>
 #include <stdint.h>
-#include <stdlib.h>
 #include <string.h>
 #include "hmac_sha512.h"
+#include "sha512.h"
 #include "zeroize.h"
 
+#define PBKDF2_DIGEST_WORDS (HMACSHA512_DIGEST_LENGTH / 8)
+#define PBKDF2_BLOCK_WORDS (SHA512_BLOCK_LENGTH / 8)
+
+static void be64dec_words(uint64_t* words, const uint8_t* bytes, size_t count)
+{
+    size_t i, j;
+    for (i = 0; i < count; i++)
+    {
+        words[i] = 0;
+        for (j = 0; j < 8; j++)
+            words[i] = (words[i] << 8) | bytes[i * 8 + j];
+    }
+}
+
+static void be64enc_words(uint8_t* bytes, const uint64_t* words, size_t count)
+{
+    size_t i, j;
+    for (i = 0; i < count; i++)
+        for (j = 0; j < 8; j++)
+            bytes[i * 8 + j] = (uint8_t)(words[i] >> (56 - 8 * j));
+}
+
+/* The HMAC key pads are hashed once, and each of the iterations then costs */
+/* exactly two compressions, performed on host order words. An iteration */
+/* hashes a 64 byte digest following the 128 byte key pad, so its message */
+/* always fits in one block with fixed padding and length. */
 int pkcs5_pbkdf2(const uint8_t* passphrase, size_t passphrase_length,
     const uint8_t* salt, size_t salt_length, uint8_t* key, size_t key_length,
     size_t iterations)
 {
-    uint8_t* asalt;
-    size_t asalt_size;
     size_t count, index, iteration, length;
+    uint8_t big_endian_count[4];
     uint8_t buffer[HMACSHA512_DIGEST_LENGTH];
-    uint8_t digest1[HMACSHA512_DIGEST_LENGTH];
-    uint8_t digest2[HMACSHA512_DIGEST_LENGTH];
+    uint64_t block[PBKDF2_BLOCK_WORDS];
+    uint64_t state[SHA512_STATE_LENGTH];
+    uint64_t result[PBKDF2_DIGEST_WORDS];
+    HMACSHA512CTX keyed;
+    HMACSHA512CTX context;
 
     /* An iteration count of 0 is equivalent to a count of 1. */
     /* A key_length of 0 is a no-op. */
     /* A salt_length of 0 is perfectly valid. */
 
-    if (salt_length > SIZE_MAX - 4)
-        return -1;
-    asalt_size = salt_length + 4;
-    asalt = malloc(asalt_size);
-    if (asalt == NULL)
-        return -1;
+    HMACSHA512Init(&keyed, passphrase, passphrase_length);
+
+    memset(block, 0, sizeof(block));
+    block[PBKDF2_DIGEST_WORDS] = 0x8000000000000000ULL;
+    block[PBKDF2_BLOCK_WORDS - 1] =
+        (SHA512_BLOCK_LENGTH + HMACSHA512_DIGEST_LENGTH) * 8;
 
-    memcpy(asalt, salt, salt_length);
     for (count = 1; key_length > 0; count++)
     {
-        asalt[salt_length + 0] = (count >> 24) & 0xff;
-        asalt[salt_length + 1] = (count >> 16) & 0xff;
-        asalt[salt_length + 2] = (count >> 8) & 0xff;
-        asalt[salt_length + 3] = (count >> 0) & 0xff;
-        HMACSHA512(asalt, asalt_size, passphrase, passphrase_length, digest1);
-        memcpy(buffer, digest1, sizeof(buffer));
+        big_endian_count[0] = (count >> 24) & 0xff;
+        big_endian_count[1] = (count >> 16) & 0xff;
+        big_endian_count[2] = (count >> 8) & 0xff;
+        big_endian_count[3] = (count >> 0) & 0xff;
+
+        context = keyed;
+        HMACSHA512Update(&context, salt, salt_length);
+        HMACSHA512Update(&context, big_endian_count, sizeof(big_endian_count));
+        HMACSHA512Final(&context, buffer);
+        be64dec_words(block, buffer, PBKDF2_DIGEST_WORDS);
+        memcpy(result, block, sizeof(result));
 
         for (iteration = 1; iteration < iterations; iteration++)
         {
-            HMACSHA512(digest1, sizeof(digest1), passphrase, passphrase_length,
-                digest2);
-            memcpy(digest1, digest2, sizeof(digest1));
-            for (index = 0; index < sizeof(buffer); index++)
-                buffer[index] ^= digest1[index];
+            memcpy(state, keyed.ictx.state, sizeof(state));
+            SHA512TransformWords(state, block);
+            memcpy(block, state, sizeof(state));
+
+            memcpy(state, keyed.octx.state, sizeof(state));
+            SHA512TransformWords(state, block);
+            memcpy(block, state, sizeof(state));
+
+            for (index = 0; index < PBKDF2_DIGEST_WORDS; index++)
+                result[index] ^= state[index];
         }
 
+        be64enc_words(buffer, result, PBKDF2_DIGEST_WORDS);
         length = (key_length < sizeof(buffer) ? key_length : sizeof(buffer));
         memcpy(key, buffer, length);
         key += length;
         key_length -= length;
     };
 
-    zeroize(digest1, sizeof(digest1));
-    zeroize(digest2, sizeof(digest2));
+    zeroize(&keyed, sizeof(keyed));
+    zeroize(block, sizeof(block));
+    zeroize(state, sizeof(state));
+    zeroize(result, sizeof(result));
     zeroize(buffer, sizeof(buffer));
-    zeroize(asalt, asalt_size);
-    free(asalt);
 
     return 0;
 }
@@ -149,16 +149,13 @@ void SHA512Pad(SHA512CTX* context)
     SHA512Update(context, len, 16);
 }
 
-void SHA512Transform(uint64_t state[SHA512_STATE_LENGTH],
-    const uint8_t block[SHA512_BLOCK_LENGTH])
+/* Expand the schedule of the decoded block W[0..15] and compress into state. */
+static void compress(uint64_t state[SHA512_STATE_LENGTH], uint64_t W[80],
+    uint64_t S[SHA512_STATE_LENGTH])
 {
     int i;
-    uint64_t W[80];
-    uint64_t S[8];
     uint64_t t0, t1;
 
-    be64dec_vect(W, block, SHA512_BLOCK_LENGTH);
-
     for (i = 16; i < 80; i++) {
         W[i] = s1(W[i - 2]) + W[i - 7] + s0(W[i - 15]) + W[i - 16];
     }
@@ -251,12 +248,36 @@ void SHA512Transform(uint64_t state[SHA512_STATE_LENGTH],
         state[i] += S[i];
     }
 
-    zeroize((void*)W, sizeof W);
-    zeroize((void*)S, sizeof S);
     zeroize((void*)&t0, sizeof t0);
     zeroize((void*)&t1, sizeof t1);
 }
 
+void SHA512Transform(uint64_t state[SHA512_STATE_LENGTH],
+    const uint8_t block[SHA512_BLOCK_LENGTH])
+{
+    uint64_t W[80];
+    uint64_t S[8];
+
+    be64dec_vect(W, block, SHA512_BLOCK_LENGTH);
+    compress(state, W, S);
+
+    zeroize((void*)W, sizeof W);
+    zeroize((void*)S, sizeof S);
+}
+
+void SHA512TransformWords(uint64_t state[SHA512_STATE_LENGTH],
+    const uint64_t block[SHA512_BLOCK_LENGTH / 8])
+{
+    uint64_t W[80];
+    uint64_t S[8];
+
+    memcpy(W, block, SHA512_BLOCK_LENGTH);
+    compress(state, W, S);
+
+    zeroize((void*)W, sizeof W);
+    zeroize((void*)S, sizeof S);
+}
+
 void SHA512Update(SHA512CTX* context, const uint8_t* input, size_t length)
 {
     uint64_t bitlen[2];
@@ -58,6 +58,10 @@ void SHA512Pad(SHA512CTX* context);
 void SHA512Transform(uint64_t state[SHA512_STATE_LENGTH],
     const uint8_t block[SHA512_BLOCK_LENGTH]);
 
+/* Transform a block of host order words (no byte order conversion). */
+void SHA512TransformWords(uint64_t state[SHA512_STATE_LENGTH],
+    const uint64_t block[SHA512_BLOCK_LENGTH / 8]);
+
 void SHA512Update(SHA512CTX* context, const uint8_t* input, size_t length);
 
 #ifdef __cplusplus
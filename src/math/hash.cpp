@@ -22,10 +22,12 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <errno.h>
 #include <new>
 #include <stdexcept>
-#include "../math/external/crypto_scrypt.h"
+#include <bitcoin/bitcoin/math/scrypt.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/instrument.hpp>
+#include <bitcoin/bitcoin/utility/random.hpp>
 #include "../math/external/hmac_sha256.h"
 #include "../math/external/hmac_sha512.h"
 #include "../math/external/pkcs5_pbkdf2.h"
@@ -36,6 +38,8 @@
 
 namespace libbitcoin {
 
+BC_METRIC(bitcoin_hash_metric, "hash.bitcoin_hash", histogram);
+
 short_hash ripemd160_hash(data_slice data)
 {
     short_hash hash;
@@ -106,6 +110,7 @@ long_hash pkcs5_pbkdf2_hmac_sha512(data_slice passphrase,
 
 hash_digest bitcoin_hash(data_slice data)
 {
+    BC_INSTRUMENT_SCOPE(bitcoin_hash_metric);
     return sha256_hash(sha256_hash(data));
 }
 
@@ -114,32 +119,69 @@ short_hash bitcoin_short_hash(data_slice data)
     return ripemd160_hash(sha256_hash(data));
 }
 
-static void handle_script_result(int result)
+data_chunk scrypt(data_slice data, data_slice salt, uint64_t N, uint32_t p,
+    uint32_t r, size_t length)
+{
+    scrypt_context context;
+    return context.hash(data, salt, N, p, r, length);
+}
+
+// salted_hash
+// ----------------------------------------------------------------------------
+
+// Odd multipliers of the 64 bit finalizer of splitmix64.
+static BC_CONSTEXPR uint64_t salt_multiplier_1 = 0xbf58476d1ce4e5b9;
+static BC_CONSTEXPR uint64_t salt_multiplier_2 = 0x94d049bb133111eb;
+
+static uint64_t finalize_mix(uint64_t value)
 {
-    if (result == 0)
-        return;
+    value = (value ^ (value >> 30)) * salt_multiplier_1;
+    value = (value ^ (value >> 27)) * salt_multiplier_2;
+    return value ^ (value >> 31);
+}
 
-    switch (errno)
-    {
-        case EFBIG:
-            throw std::length_error("scrypt parameter too large");
-        case EINVAL:
-            throw std::runtime_error("scrypt invalid argument");
-        case ENOMEM:
-            throw std::length_error("scrypt address space");
-        default:
-            throw std::bad_alloc();
-    }
+// The salt must not be predictable, so it is drawn from the random device.
+// This is a system call per hasher construction, not per hash.
+salted_hash::salted_hash()
+  : salt_(secure_random())
+{
 }
 
-data_chunk scrypt(data_slice data, data_slice salt, uint64_t N, uint32_t p,
-    uint32_t r, size_t length)
+salted_hash::salted_hash(uint64_t salt)
+  : salt_(salt)
 {
-    data_chunk output(length);
-    const auto result = crypto_scrypt(data.data(), data.size(), salt.data(),
-        salt.size(), N, r, p, output.data(), output.size());
-    handle_script_result(result);
-    return output;
+}
+
+size_t salted_hash::operator()(const short_hash& hash) const
+{
+    return mix(hash.data(), hash.size());
+}
+
+size_t salted_hash::operator()(const hash_digest& hash) const
+{
+    return mix(hash.data(), hash.size());
+}
+
+size_t salted_hash::operator()(const long_hash& hash) const
+{
+    return mix(hash.data(), hash.size());
+}
+
+// Each word is folded into the salted state, so every byte is significant.
+size_t salted_hash::mix(const uint8_t* data, size_t size) const
+{
+    auto state = salt_;
+    size_t position = 0;
+
+    for (; position + sizeof(uint64_t) <= size; position += sizeof(uint64_t))
+        state = finalize_mix(state ^
+            from_little_endian_unsafe<uint64_t>(data + position));
+
+    if (position < size)
+        state = finalize_mix(state ^
+            from_little_endian_unsafe<uint32_t>(data + position));
+
+    return static_cast<size_t>(state);
 }
 
 } // namespace libbitcoin
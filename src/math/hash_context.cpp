@@ -0,0 +1,395 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/hash_context.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include "../math/external/hmac_sha256.h"
+#include "../math/external/hmac_sha512.h"
+#include "../math/external/ripemd160.h"
+#include "../math/external/sha1.h"
+#include "../math/external/sha256.h"
+#include "../math/external/sha512.h"
+#include "../math/external/zeroize.h"
+
+namespace libbitcoin {
+
+// hash_writer
+// ----------------------------------------------------------------------------
+
+hash_writer::~hash_writer()
+{
+}
+
+void hash_writer::update(data_slice data)
+{
+    append(data.data(), data.size());
+}
+
+void hash_writer::update(const uint8_t* data, size_t size)
+{
+    append(data, size);
+}
+
+hash_writer::operator bool() const
+{
+    return true;
+}
+
+bool hash_writer::operator!() const
+{
+    return false;
+}
+
+void hash_writer::write_byte(uint8_t value)
+{
+    append(&value, sizeof(value));
+}
+
+void hash_writer::write_data(const data_chunk& data)
+{
+    append(data.data(), data.size());
+}
+
+void hash_writer::write_data(const uint8_t* data, size_t size)
+{
+    append(data, size);
+}
+
+void hash_writer::write_hash(const hash_digest& value)
+{
+    append(value.data(), value.size());
+}
+
+void hash_writer::write_short_hash(const short_hash& value)
+{
+    append(value.data(), value.size());
+}
+
+void hash_writer::write_2_bytes_little_endian(uint16_t value)
+{
+    const auto bytes = to_little_endian(value);
+    append(bytes.data(), bytes.size());
+}
+
+void hash_writer::write_4_bytes_little_endian(uint32_t value)
+{
+    const auto bytes = to_little_endian(value);
+    append(bytes.data(), bytes.size());
+}
+
+void hash_writer::write_8_bytes_little_endian(uint64_t value)
+{
+    const auto bytes = to_little_endian(value);
+    append(bytes.data(), bytes.size());
+}
+
+void hash_writer::write_variable_uint_little_endian(uint64_t value)
+{
+    if (value < 0xfd)
+    {
+        write_byte((uint8_t)value);
+    }
+    else if (value <= 0xffff)
+    {
+        write_byte(0xfd);
+        write_2_bytes_little_endian((uint16_t)value);
+    }
+    else if (value <= 0xffffffff)
+    {
+        write_byte(0xfe);
+        write_4_bytes_little_endian((uint32_t)value);
+    }
+    else
+    {
+        write_byte(0xff);
+        write_8_bytes_little_endian(value);
+    }
+}
+
+void hash_writer::write_2_bytes_big_endian(uint16_t value)
+{
+    const auto bytes = to_big_endian(value);
+    append(bytes.data(), bytes.size());
+}
+
+void hash_writer::write_4_bytes_big_endian(uint32_t value)
+{
+    const auto bytes = to_big_endian(value);
+    append(bytes.data(), bytes.size());
+}
+
+void hash_writer::write_8_bytes_big_endian(uint64_t value)
+{
+    const auto bytes = to_big_endian(value);
+    append(bytes.data(), bytes.size());
+}
+
+void hash_writer::write_variable_uint_big_endian(uint64_t value)
+{
+    if (value < 0xfd)
+    {
+        write_byte((uint8_t)value);
+    }
+    else if (value <= 0xffff)
+    {
+        write_byte(0xfd);
+        write_2_bytes_big_endian((uint16_t)value);
+    }
+    else if (value <= 0xffffffff)
+    {
+        write_byte(0xfe);
+        write_4_bytes_big_endian((uint32_t)value);
+    }
+    else
+    {
+        write_byte(0xff);
+        write_8_bytes_big_endian(value);
+    }
+}
+
+void hash_writer::write_fixed_string(const std::string& value, size_t size)
+{
+    const auto min_size = std::min(size, value.size());
+    const auto text = reinterpret_cast<const uint8_t*>(value.data());
+    append(text, min_size);
+
+    // Pad with zeroes without allocating.
+    for (auto index = min_size; index < size; ++index)
+        write_byte(0x00);
+}
+
+void hash_writer::write_string(const std::string& value)
+{
+    write_variable_uint_little_endian(value.size());
+    const auto text = reinterpret_cast<const uint8_t*>(value.data());
+    append(text, value.size());
+}
+
+// The external contexts are plain structs, held in the storage of each
+// context, which must be large and aligned enough for them.
+template <typename Context, typename Storage>
+static Context* get(Storage& storage)
+{
+    static_assert(sizeof(Context) <= sizeof(Storage),
+        "hash context storage is too small");
+    static_assert(std::alignment_of<Context>::value <=
+        std::alignment_of<Storage>::value,
+        "hash context storage is misaligned");
+    return reinterpret_cast<Context*>(&storage);
+}
+
+// sha1_context
+// ----------------------------------------------------------------------------
+
+sha1_context::sha1_context()
+{
+    reset();
+}
+
+void sha1_context::reset()
+{
+    SHA1Init(get<SHA1CTX>(context_));
+}
+
+short_hash sha1_context::finalize()
+{
+    short_hash hash;
+    SHA1Final(get<SHA1CTX>(context_), hash.data());
+    reset();
+    return hash;
+}
+
+void sha1_context::append(const uint8_t* data, size_t size)
+{
+    SHA1Update(get<SHA1CTX>(context_), data, size);
+}
+
+// ripemd160_context
+// ----------------------------------------------------------------------------
+
+ripemd160_context::ripemd160_context()
+{
+    reset();
+}
+
+void ripemd160_context::reset()
+{
+    RMD160Init(get<RMD160CTX>(context_));
+}
+
+short_hash ripemd160_context::finalize()
+{
+    short_hash hash;
+    RMD160Final(get<RMD160CTX>(context_), hash.data());
+    reset();
+    return hash;
+}
+
+void ripemd160_context::append(const uint8_t* data, size_t size)
+{
+    RMD160Update(get<RMD160CTX>(context_), data, size);
+}
+
+// sha256_context
+// ----------------------------------------------------------------------------
+
+sha256_context::sha256_context()
+{
+    reset();
+}
+
+void sha256_context::reset()
+{
+    SHA256Init(get<SHA256CTX>(context_));
+}
+
+hash_digest sha256_context::finalize()
+{
+    hash_digest hash;
+    SHA256Final(get<SHA256CTX>(context_), hash.data());
+    reset();
+    return hash;
+}
+
+void sha256_context::append(const uint8_t* data, size_t size)
+{
+    SHA256Update(get<SHA256CTX>(context_), data, size);
+}
+
+// sha512_context
+// ----------------------------------------------------------------------------
+
+sha512_context::sha512_context()
+{
+    reset();
+}
+
+void sha512_context::reset()
+{
+    SHA512Init(get<SHA512CTX>(context_));
+}
+
+long_hash sha512_context::finalize()
+{
+    long_hash hash;
+    SHA512Final(get<SHA512CTX>(context_), hash.data());
+    reset();
+    return hash;
+}
+
+void sha512_context::append(const uint8_t* data, size_t size)
+{
+    SHA512Update(get<SHA512CTX>(context_), data, size);
+}
+
+// hmac_sha256_context
+// ----------------------------------------------------------------------------
+
+hmac_sha256_context::hmac_sha256_context(data_slice key)
+{
+    HMACSHA256Init(get<HMACSHA256CTX>(keyed_), key.data(), key.size());
+    reset();
+}
+
+// The keyed state is derived from the key, so clear it.
+hmac_sha256_context::~hmac_sha256_context()
+{
+    zeroize(&keyed_, sizeof(keyed_));
+    zeroize(&context_, sizeof(context_));
+}
+
+void hmac_sha256_context::reset()
+{
+    context_ = keyed_;
+}
+
+hash_digest hmac_sha256_context::finalize()
+{
+    hash_digest hash;
+    HMACSHA256Final(get<HMACSHA256CTX>(context_), hash.data());
+    reset();
+    return hash;
+}
+
+void hmac_sha256_context::append(const uint8_t* data, size_t size)
+{
+    HMACSHA256Update(get<HMACSHA256CTX>(context_), data, size);
+}
+
+// hmac_sha512_context
+// ----------------------------------------------------------------------------
+
+hmac_sha512_context::hmac_sha512_context(data_slice key)
+{
+    HMACSHA512Init(get<HMACSHA512CTX>(keyed_), key.data(), key.size());
+    reset();
+}
+
+// The keyed state is derived from the key, so clear it.
+hmac_sha512_context::~hmac_sha512_context()
+{
+    zeroize(&keyed_, sizeof(keyed_));
+    zeroize(&context_, sizeof(context_));
+}
+
+void hmac_sha512_context::reset()
+{
+    context_ = keyed_;
+}
+
+long_hash hmac_sha512_context::finalize()
+{
+    long_hash hash;
+    HMACSHA512Final(get<HMACSHA512CTX>(context_), hash.data());
+    reset();
+    return hash;
+}
+
+void hmac_sha512_context::append(const uint8_t* data, size_t size)
+{
+    HMACSHA512Update(get<HMACSHA512CTX>(context_), data, size);
+}
+
+// bitcoin_hash_context
+// ----------------------------------------------------------------------------
+
+void bitcoin_hash_context::reset()
+{
+    context_.reset();
+}
+
+hash_digest bitcoin_hash_context::finalize()
+{
+    return sha256_hash(context_.finalize());
+}
+
+void bitcoin_hash_context::append(const uint8_t* data, size_t size)
+{
+    context_.update(data, size);
+}
+
+} // namespace libbitcoin
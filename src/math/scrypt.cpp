@@ -0,0 +1,167 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/scrypt.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <errno.h>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include "../math/external/crypto_scrypt.h"
+#include "../math/external/pbkdf2_sha256.h"
+#include "../math/external/zeroize.h"
+
+namespace libbitcoin {
+
+static void handle_script_result(int result)
+{
+    if (result == 0)
+        return;
+
+    switch (errno)
+    {
+        case EFBIG:
+            throw std::length_error("scrypt parameter too large");
+        case EINVAL:
+            throw std::runtime_error("scrypt invalid argument");
+        case ENOMEM:
+            throw std::length_error("scrypt address space");
+        default:
+            throw std::bad_alloc();
+    }
+}
+
+static size_t hardware_threads()
+{
+    const auto threads = std::thread::hardware_concurrency();
+    return threads == 0 ? 1 : threads;
+}
+
+// The scratch holds state derived from the passphrase, so clear it.
+static void wipe(data_chunk& buffer)
+{
+    zeroize(buffer.data(), buffer.size());
+}
+
+scrypt_context::scrypt_context(size_t threads)
+  : threads_(threads == 0 ? hardware_threads() : threads)
+{
+}
+
+scrypt_context::~scrypt_context()
+{
+    for (auto& scratch: scratch_)
+        wipe(scratch);
+}
+
+size_t scrypt_context::scratch_size(uint64_t N, uint32_t r)
+{
+    return crypto_scrypt_scratch_size(N, r);
+}
+
+size_t scrypt_context::threads() const
+{
+    return threads_;
+}
+
+void scrypt_context::clear()
+{
+    for (auto& scratch: scratch_)
+        wipe(scratch);
+
+    scratch_.clear();
+    scratch_.shrink_to_fit();
+}
+
+// Scratch is only ever grown, so that alternating parameters do not thrash.
+void scrypt_context::reserve(size_t threads, size_t size)
+{
+    if (scratch_.size() < threads)
+        scratch_.resize(threads);
+
+    // A grown buffer is replaced, not copied, so the old one is cleared.
+    for (size_t index = 0; index < threads; ++index)
+    {
+        if (scratch_[index].size() < size)
+        {
+            wipe(scratch_[index]);
+            scratch_[index] = data_chunk(size);
+        }
+    }
+}
+
+data_chunk scrypt_context::hash(data_slice data, data_slice salt, uint64_t N,
+    uint32_t p, uint32_t r, size_t length)
+{
+    handle_script_result(crypto_scrypt_check(N, r, p, length));
+
+    // All allocation occurs here, the lane computations cannot fail.
+    const size_t workers = std::min(threads_, static_cast<size_t>(p));
+    const size_t lane_size = 128 * static_cast<size_t>(r);
+    reserve(workers, scratch_size(N, r));
+    data_chunk lanes(lane_size * p);
+    data_chunk output(length);
+
+    // (B_0 ... B_{p-1}) <-- PBKDF2(P, S, 1, p * MFLen)
+    pbkdf2_sha256(data.data(), data.size(), salt.data(), salt.size(), 1,
+        lanes.data(), lanes.size());
+
+    // B_i <-- MF(B_i, N), with lanes distributed evenly over the workers.
+    const auto mix = [&](size_t worker)
+    {
+        auto scratch = scratch_[worker].data();
+        for (size_t lane = worker; lane < p; lane += workers)
+            crypto_scrypt_smix(&lanes[lane * lane_size], r, N, scratch);
+    };
+
+    // The calling thread is the first worker, and mixes the lanes of any
+    // worker that cannot be started. Mixing itself cannot throw.
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (size_t worker = 1; worker < workers; ++worker)
+    {
+        try
+        {
+            threads.emplace_back(mix, worker);
+        }
+        catch (const std::system_error&)
+        {
+            mix(worker);
+        }
+    }
+
+    mix(0);
+    for (auto& thread: threads)
+        thread.join();
+
+    // DK <-- PBKDF2(P, B, 1, dkLen)
+    pbkdf2_sha256(data.data(), data.size(), lanes.data(), lanes.size(), 1,
+        output.data(), output.size());
+
+    wipe(lanes);
+    return output;
+}
+
+} // namespace libbitcoin
@@ -20,10 +20,17 @@
 #include <bitcoin/bitcoin/math/stealth.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
 #include <bitcoin/bitcoin/chain/operation.hpp>
 #include <bitcoin/bitcoin/chain/script.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/hash_context.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/binary.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
@@ -32,6 +39,9 @@ namespace libbitcoin {
 
 using namespace chain;
 
+// Nonces are claimed by mining workers in blocks of this many, in order.
+static const uint64_t nonce_block_size = 4096;
+
 bool is_stealth_script(const script& script)
 {
     if (script.pattern() != chain::script_pattern::null_data)
@@ -90,9 +100,116 @@ bool create_ephemeral_key(ec_secret& out_secret, const data_chunk& seed)
     return create_ephemeral_keys(out_secret, unused, seed);
 }
 
+// The first 32 bits of the filter, as a big endian mask and value.
+static void to_filter_mask(uint32_t& out_mask, uint32_t& out_value,
+    const binary_type& filter)
+{
+    static BC_CONSTEXPR size_t prefix_bits = sizeof(uint32_t) * byte_bits;
+    const auto bits = std::min(filter.size(), prefix_bits);
+    const auto& blocks = filter.blocks();
+
+    byte_array<sizeof(uint32_t)> prefix{ { 0, 0, 0, 0 } };
+    std::copy(blocks.begin(), blocks.begin() +
+        std::min(blocks.size(), prefix.size()), prefix.begin());
+
+    out_mask = bits == 0 ? 0 : max_uint32 << (prefix_bits - bits);
+    out_value = from_big_endian_unsafe<uint32_t>(prefix.begin()) & out_mask;
+}
+
+// Find the least offset from start of a nonce that mines the filter into
+// the script hash. The script is serialized once with the nonce last, so
+// each attempt only hashes the nonce onto the midstate of the remainder.
+// Workers claim nonce blocks in order and abandon blocks beyond any match,
+// so the result is independent of the number of threads.
+static bool mine_stealth_nonce(uint32_t& out_nonce, const data_chunk& data,
+    const binary_type& filter, uint32_t start, size_t threads)
+{
+    const auto serialized = script{ operation::to_null_data_pattern(data) }
+        .to_data(false);
+
+    BITCOIN_ASSERT(serialized.size() > sizeof(uint32_t));
+    const auto prefix_size = serialized.size() - sizeof(uint32_t);
+
+    sha256_context midstate;
+    midstate.update(serialized.data(), prefix_size);
+
+    uint32_t mask;
+    uint32_t value;
+    to_filter_mask(mask, value, filter);
+
+    // This will iterate up to 2^32 - 1 times before giving up.
+    static BC_CONSTEXPR uint64_t span = max_uint32;
+    const auto blocks = (span + nonce_block_size - 1) / nonce_block_size;
+
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    threads = static_cast<size_t>(std::min(static_cast<uint64_t>(threads),
+        blocks));
+
+    std::atomic<uint64_t> next(0);
+    std::atomic<uint64_t> found(span);
+
+    const auto lower_found = [&found](uint64_t offset)
+    {
+        auto current = found.load();
+        while (offset < current)
+            if (found.compare_exchange_weak(current, offset))
+                break;
+    };
+
+    const auto work = [&]()
+    {
+        auto context = midstate;
+
+        for (auto block = next++; block < blocks &&
+            block * nonce_block_size < found.load(); block = next++)
+        {
+            const auto first = block * nonce_block_size;
+            const auto last = std::min(first + nonce_block_size, span);
+
+            for (auto offset = first; offset < last && offset < found.load();
+                ++offset)
+            {
+                const auto nonce = static_cast<uint32_t>(start + 1 + offset);
+                const auto bytes = to_little_endian(nonce);
+
+                context = midstate;
+                context.update(bytes.data(), bytes.size());
+                const auto hash = sha256_hash(context.finalize());
+                const auto field = from_big_endian_unsafe<uint32_t>(
+                    hash.begin());
+
+                // The mask excludes most candidates without allocation.
+                if ((field & mask) != value || !filter.is_prefix_of(
+                    from_little_endian_unsafe<uint32_t>(hash.begin())))
+                    continue;
+
+                lower_found(offset);
+                break;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t worker = 1; worker < threads; ++worker)
+        workers.emplace_back(work);
+
+    work();
+
+    for (auto& worker: workers)
+        worker.join();
+
+    if (found.load() == span)
+        return false;
+
+    out_nonce = static_cast<uint32_t>(start + 1 + found.load());
+    return true;
+}
+
 // Mine a filter into the leftmost bytes of sha256(sha256(output-script)).
 bool create_stealth_data(data_chunk& out_stealth_data, ec_secret& out_secret,
-    const binary_type& filter, const data_chunk& seed)
+    const binary_type& filter, const data_chunk& seed, size_t threads)
 {
     // Create a valid ephemeral key pair.
     ec_secret secret;
@@ -125,25 +242,18 @@ bool create_stealth_data(data_chunk& out_stealth_data, ec_secret& out_secret,
         max_pad_size);
 
     // Mine a prefix into the double sha256 hash of the stealth script.
-    // This will iterate up to 2^32 times before giving up.
-    for (uint32_t nonce = start + 1; nonce != start; ++nonce)
-    {
-        // Create the stealth script with the current data.
-        const auto ops = operation::to_null_data_pattern(data);
-        const auto stealth_script = script{ ops };
-
-        // Test for match of filter to stealth script hash prefix.
-        uint32_t field;
-        if (to_stealth_prefix(field, stealth_script) &&
-            filter.is_prefix_of(field))
-        {
-            out_stealth_data = data;
-            out_secret = secret;
-            return true;
-        }
-    }
+    uint32_t nonce;
+    if (!mine_stealth_nonce(nonce, data, filter, start, threads))
+        return false;
 
-    return false;
+    // Write the mined nonce into the trailing bytes of the data.
+    const auto nonce_bytes = to_little_endian(nonce);
+    std::copy(nonce_bytes.begin(), nonce_bytes.end(),
+        data.end() - sizeof(uint32_t));
+
+    out_stealth_data = data;
+    out_secret = secret;
+    return true;
 }
 
 bool extract_ephemeral_key(ec_compressed& out_ephemeral_public_key,
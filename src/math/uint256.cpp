@@ -9,8 +9,128 @@
 #include <string.h>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 
+#if defined(_MSC_VER) && defined(_M_X64)
+    #include <intrin.h>
+    #pragma intrinsic(_umul128)
+#endif
+
 namespace libbitcoin {
 
+// Returns the low 64 bits of the product, setting high to the high 64 bits.
+static inline uint64_t multiply(uint64_t a, uint64_t b, uint64_t& high)
+{
+#if defined(__SIZEOF_INT128__)
+    const auto product = static_cast<unsigned __int128>(a) * b;
+    high = static_cast<uint64_t>(product >> 64);
+    return static_cast<uint64_t>(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(a, b, &high);
+#else
+    const uint64_t a_low = a & 0xffffffff, a_high = a >> 32;
+    const uint64_t b_low = b & 0xffffffff, b_high = b >> 32;
+    const uint64_t low_low = a_low * b_low;
+    const uint64_t high_low = a_high * b_low;
+    const uint64_t low_high = a_low * b_high;
+    const uint64_t high_high = a_high * b_high;
+    const uint64_t cross = (low_low >> 32) + (high_low & 0xffffffff) +
+        low_high;
+    high = high_high + (high_low >> 32) + (cross >> 32);
+    return (cross << 32) | (low_low & 0xffffffff);
+#endif
+}
+
+// Returns the number of leading zero bits of a non-zero 32 bit value.
+static inline int leading_zeros(uint32_t value)
+{
+    int count = 0;
+    for (uint32_t mask = 0x80000000; (value & mask) == 0; mask >>= 1)
+        count++;
+
+    return count;
+}
+
+// Knuth's algorithm D (TAOCP 4.3.1) on 32 bit digits, least significant
+// first. Requires divisor_size >= 2 and a non-zero most significant divisor
+// digit. The quotient has dividend_size - divisor_size + 1 digits.
+static void divide(uint32_t* quotient, const uint32_t* dividend,
+    int dividend_size, const uint32_t* divisor, int divisor_size,
+    uint32_t* scratch)
+{
+    static const uint64_t base = 0x100000000;
+    const int m = dividend_size;
+    const int n = divisor_size;
+
+    // Normalize so that the most significant divisor digit has its top bit
+    // set, which bounds the error of each quotient digit estimate to two.
+    const int shift = leading_zeros(divisor[n - 1]);
+    uint32_t* un = scratch;
+    uint32_t* vn = scratch + m + 1;
+
+    for (int i = n - 1; i > 0; i--)
+        vn[i] = static_cast<uint32_t>((divisor[i] << shift) |
+            (static_cast<uint64_t>(divisor[i - 1]) >> (32 - shift)));
+
+    vn[0] = divisor[0] << shift;
+    un[m] = static_cast<uint32_t>(
+        static_cast<uint64_t>(dividend[m - 1]) >> (32 - shift));
+
+    for (int i = m - 1; i > 0; i--)
+        un[i] = static_cast<uint32_t>((dividend[i] << shift) |
+            (static_cast<uint64_t>(dividend[i - 1]) >> (32 - shift)));
+
+    un[0] = dividend[0] << shift;
+
+    for (int j = m - n; j >= 0; j--)
+    {
+        // Estimate the quotient digit from the leading digits.
+        const uint64_t numerator =
+            (static_cast<uint64_t>(un[j + n]) << 32) | un[j + n - 1];
+        uint64_t estimate = numerator / vn[n - 1];
+        uint64_t remainder = numerator - estimate * vn[n - 1];
+
+        while (estimate >= base || estimate * vn[n - 2] >
+            ((remainder << 32) | un[j + n - 2]))
+        {
+            estimate--;
+            remainder += vn[n - 1];
+            if (remainder >= base)
+                break;
+        }
+
+        // Multiply and subtract.
+        int64_t borrow = 0;
+        int64_t difference;
+        for (int i = 0; i < n; i++)
+        {
+            const uint64_t product = estimate * vn[i];
+            difference = un[i + j] - borrow -
+                static_cast<int64_t>(product & 0xffffffff);
+            un[i + j] = static_cast<uint32_t>(difference);
+            borrow = static_cast<int64_t>(product >> 32) - (difference >> 32);
+        }
+
+        difference = un[j + n] - borrow;
+        un[j + n] = static_cast<uint32_t>(difference);
+        quotient[j] = static_cast<uint32_t>(estimate);
+
+        // The estimate was one too large, so add back.
+        if (difference < 0)
+        {
+            quotient[j]--;
+            uint64_t carry = 0;
+            for (int i = 0; i < n; i++)
+            {
+                const uint64_t sum = static_cast<uint64_t>(un[i + j]) +
+                    vn[i] + carry;
+                un[i + j] = static_cast<uint32_t>(sum);
+                carry = sum >> 32;
+            }
+
+            un[j + n] += static_cast<uint32_t>(carry);
+        }
+    }
+}
+
 template <unsigned int BITS>
 base_uint<BITS>::base_uint(const std::vector<unsigned char>& vch)
 {
@@ -23,19 +143,19 @@ base_uint<BITS>::base_uint(const std::vector<unsigned char>& vch)
 template <unsigned int BITS>
 base_uint<BITS>& base_uint<BITS>::operator<<=(unsigned int shift)
 {
-    base_uint<BITS> a(*this);
-    for (int i = 0; i < WIDTH; i++)
-        pn[i] = 0;
+    const int k = shift / 64;
+    shift = shift % 64;
 
-    int k = shift / 32;
-    shift = shift % 32;
-    for (int i = 0; i < WIDTH; i++)
+    for (int i = WIDTH - 1; i >= 0; i--)
     {
-        if (i + k + 1 < WIDTH && shift != 0)
-            pn[i + k + 1] |= (a.pn[i] >> (32 - shift));
+        uint64_t limb = 0;
+        if (i - k >= 0)
+            limb = pn[i - k] << shift;
 
-        if (i + k < WIDTH)
-            pn[i + k] |= (a.pn[i] << shift);
+        if (i - k - 1 >= 0 && shift != 0)
+            limb |= pn[i - k - 1] >> (64 - shift);
+
+        pn[i] = limb;
     }
 
     return *this;
@@ -44,19 +164,19 @@ base_uint<BITS>& base_uint<BITS>::operator<<=(unsigned int shift)
 template <unsigned int BITS>
 base_uint<BITS>& base_uint<BITS>::operator>>=(unsigned int shift)
 {
-    base_uint<BITS> a(*this);
-    for (int i = 0; i < WIDTH; i++)
-        pn[i] = 0;
+    const int k = shift / 64;
+    shift = shift % 64;
 
-    int k = shift / 32;
-    shift = shift % 32;
     for (int i = 0; i < WIDTH; i++)
     {
-        if (i - k - 1 >= 0 && shift != 0)
-            pn[i - k - 1] |= (a.pn[i] << (32 - shift));
+        uint64_t limb = 0;
+        if (i + k < WIDTH)
+            limb = pn[i + k] >> shift;
 
-        if (i - k >= 0)
-            pn[i - k] |= (a.pn[i] >> shift);
+        if (i + k + 1 < WIDTH && shift != 0)
+            limb |= pn[i + k + 1] << (64 - shift);
+
+        pn[i] = limb;
     }
 
     return *this;
@@ -68,9 +188,10 @@ base_uint<BITS>& base_uint<BITS>::operator*=(uint32_t b32)
     uint64_t carry = 0;
     for (int i = 0; i < WIDTH; i++)
     {
-        uint64_t n = carry + (uint64_t)b32 * pn[i];
-        pn[i] = n & 0xffffffff;
-        carry = n >> 32;
+        uint64_t high;
+        const uint64_t low = multiply(pn[i], b32, high);
+        pn[i] = low + carry;
+        carry = high + (pn[i] < low ? 1 : 0);
     }
 
     return *this;
@@ -79,64 +200,93 @@ base_uint<BITS>& base_uint<BITS>::operator*=(uint32_t b32)
 template <unsigned int BITS>
 base_uint<BITS>& base_uint<BITS>::operator*=(const base_uint& b)
 {
-    base_uint<BITS> a = *this;
-    *this = 0;
+    // The product is truncated, so only the lower triangle is computed.
+    uint64_t product[WIDTH] = { 0 };
     for (int j = 0; j < WIDTH; j++)
     {
         uint64_t carry = 0;
         for (int i = 0; i + j < WIDTH; i++)
         {
-            uint64_t n = carry + pn[i + j] + (uint64_t)a.pn[j] * b.pn[i];
-            pn[i + j] = n & 0xffffffff;
-            carry = n >> 32;
+            uint64_t high;
+            const uint64_t low = multiply(pn[j], b.pn[i], high);
+            const uint64_t sum = product[i + j] + low;
+            const uint64_t total = sum + carry;
+            carry = high + (sum < low ? 1 : 0) + (total < sum ? 1 : 0);
+            product[i + j] = total;
         }
     }
 
+    memcpy(pn, product, sizeof(pn));
     return *this;
 }
 
 template <unsigned int BITS>
 base_uint<BITS>& base_uint<BITS>::operator/=(const base_uint& b)
 {
-    // make a copy, so we can shift.
-    base_uint<BITS> div = b;
-
-    // make a copy, so we can subtract.
-    base_uint<BITS> num = *this; 
-
-    // the quotient.
-    *this = 0;
-
-    int num_bits = num.bits();
-    int div_bits = div.bits();
+    const int num_bits = bits();
+    const int div_bits = b.bits();
     if (div_bits == 0)
         throw uint_error("Division by zero");
 
     // the result is certainly 0.
     if (div_bits > num_bits)
+        return *this = 0;
+
+    // A single limb divisor only requires a pass of short division.
+#if defined(__SIZEOF_INT128__)
+    if (div_bits <= 64)
+    {
+        const uint64_t divisor = b.pn[0];
+        unsigned __int128 remainder = 0;
+        for (int i = (num_bits - 1) / 64; i >= 0; i--)
+        {
+            remainder = (remainder << 64) | pn[i];
+            pn[i] = static_cast<uint64_t>(remainder / divisor);
+            remainder %= divisor;
+        }
+
         return *this;
+    }
+#endif
 
-    int shift = num_bits - div_bits;
+    // Otherwise divide on 32 bit digits, trimmed to the significant digits.
+    enum { digits = BITS / 32 };
+    uint32_t dividend[digits];
+    uint32_t divisor[digits];
+    uint32_t quotient[digits] = { 0 };
+    uint32_t scratch[2 * digits + 1];
+
+    for (int i = 0; i < WIDTH; i++)
+    {
+        dividend[2 * i] = static_cast<uint32_t>(pn[i]);
+        dividend[2 * i + 1] = static_cast<uint32_t>(pn[i] >> 32);
+        divisor[2 * i] = static_cast<uint32_t>(b.pn[i]);
+        divisor[2 * i + 1] = static_cast<uint32_t>(b.pn[i] >> 32);
+    }
 
-    // shift so that div and nun align.
-    div <<= shift;
+    const int dividend_size = (num_bits + 31) / 32;
+    const int divisor_size = (div_bits + 31) / 32;
 
-    while (shift >= 0)
+    if (divisor_size == 1)
     {
-        if (num >= div)
+        uint64_t remainder = 0;
+        for (int i = dividend_size - 1; i >= 0; i--)
         {
-            num -= div;
-
-            // set a bit of the result.
-            pn[shift / 32] |= (1 << (shift & 31));
+            remainder = (remainder << 32) | dividend[i];
+            quotient[i] = static_cast<uint32_t>(remainder / divisor[0]);
+            remainder %= divisor[0];
         }
-
-        // shift back.
-        div >>= 1;
-        shift--;
     }
+    else
+    {
+        divide(quotient, dividend, dividend_size, divisor, divisor_size,
+            scratch);
+    }
+
+    for (int i = 0; i < WIDTH; i++)
+        pn[i] = quotient[2 * i] |
+            (static_cast<uint64_t>(quotient[2 * i + 1]) << 32);
 
-    // num now contains the remainder of the division.
     return *this;
 }
 
@@ -158,17 +308,11 @@ int base_uint<BITS>::CompareTo(const base_uint<BITS>& b) const
 template <unsigned int BITS>
 bool base_uint<BITS>::EqualTo(uint64_t b) const
 {
-    for (int i = WIDTH - 1; i >= 2; i--)
+    for (int i = WIDTH - 1; i >= 1; i--)
         if (pn[i] != 0)
             return false;
 
-    if (pn[1] != (b >> 32))
-        return false;
-
-    if (pn[0] != (b & 0xfffffffful))
-        return false;
-
-    return true;
+    return pn[0] == b;
 }
 
 template <unsigned int BITS>
@@ -178,11 +322,15 @@ unsigned int base_uint<BITS>::bits() const
     {
         if (pn[pos] != 0)
         {
-            for (int bits = 31; bits > 0; bits--)
-                if ((pn[pos] & 1 << bits) != 0)
-                    return 32 * pos + bits + 1;
-
-            return 32 * pos + 1;
+#if defined(__GNUC__)
+            return 64 * pos + 64 - __builtin_clzll(pn[pos]);
+#else
+            for (int bits = 63; bits > 0; bits--)
+                if ((pn[pos] & (uint64_t)1 << bits) != 0)
+                    return 64 * pos + bits + 1;
+
+            return 64 * pos + 1;
+#endif
         }
     }
 
@@ -211,8 +359,15 @@ uint32_t uint256_t::GetCompact(bool fNegative) const
     }
     else
     {
-        uint256_t bn = *this >> 8 * (nSize - 3);
-        nCompact = (uint32_t)(bn.GetLow64());
+        // Extract the three most significant bytes without a full shift.
+        const unsigned int shift = 8 * (nSize - 3);
+        const int limb = shift / 64;
+        const unsigned int offset = shift % 64;
+        uint64_t word = pn[limb] >> offset;
+        if (offset > 40 && limb + 1 < WIDTH)
+            word |= pn[limb + 1] << (64 - offset);
+
+        nCompact = (uint32_t)(word & 0x00ffffff);
     }
 
     // The 0x00800000 bit denotes the sign. Thus, if it is already set,
@@ -31,6 +31,8 @@
 #include <bitcoin/bitcoin/utility/log.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
+#include <boost/asio/yield.hpp>
+
 INITIALIZE_TRACK(bc::network::protocol_address);
 
 namespace libbitcoin {
@@ -47,6 +49,8 @@ protocol_address::protocol_address(threadpool& pool, p2p& network,
     channel::ptr channel)
   : protocol_events(pool, channel, NAME),
     network_(network),
+    address_(nullptr),
+    get_address_(nullptr),
     CONSTRUCT_TRACK(protocol_address, LOG_PROTOCOL)
 {
 }
@@ -65,12 +69,12 @@ void protocol_address::start(const settings& settings)
 
     protocol_events::start();
 
-    SUBSCRIBE2(get_address, handle_receive_get_address, _1, _2);
+    respond_get_address(error::success);
     SEND1(get_address(), handle_send_get_address, _1);
 }
 
-void protocol_address::handle_receive_address(const code& ec,
-    const address& message)
+// This is resumed by each address message received, and stores it.
+void protocol_address::receive_addresses(const code& ec)
 {
     if (stopped())
         return;
@@ -84,19 +88,25 @@ void protocol_address::handle_receive_address(const code& ec,
         return;
     }
 
-    // Resubscribe to address messages.
-    SUBSCRIBE2(address, handle_receive_address, _1, _2);
-
-    log::debug(LOG_PROTOCOL)
-        << "Storing addresses from [" << authority() << "] ("
-        << message.addresses.size() << ")";
-
-    // TODO: manage timestamps (active channels are connected < 3 hours ago).
-    network_.store(message.addresses, BIND1(handle_store_addresses, _1));
+    reenter(receiver_)
+    {
+        for (;;)
+        {
+            yield RECEIVE(address_, receive_addresses);
+
+            log::debug(LOG_PROTOCOL)
+                << "Storing addresses from [" << authority() << "] ("
+                << address_->addresses.size() << ")";
+
+            // TODO: manage timestamps (active channels connected < 3 hours).
+            network_.store(address_->addresses,
+                BIND1(handle_store_addresses, _1));
+        }
+    }
 }
 
-void protocol_address::handle_receive_get_address(const code& ec,
-    const get_address& message)
+// This is resumed by each get_address message received, and answers it.
+void protocol_address::respond_get_address(const code& ec)
 {
     if (stopped())
         return;
@@ -110,20 +120,26 @@ void protocol_address::handle_receive_get_address(const code& ec,
         return;
     }
 
-    // TODO: allowing repeated queries can allow a channel to map our history.
-    // Resubscribe to get_address messages.
-    SUBSCRIBE2(get_address, handle_receive_get_address, _1, _2);
-
-    // TODO: pull active hosts from host cache (currently just resending self).
-    // TODO: need to distort for privacy, don't send currently-connected peers.
-    if (self_.addresses.empty())
-        return;
-
-    log::debug(LOG_PROTOCOL)
-        << "Sending addresses to [" << authority() << "] ("
-        << self_.addresses.size() << ")";
-
-    SEND1(self_, handle_send_address, _1);
+    reenter(responder_)
+    {
+        for (;;)
+        {
+            // TODO: allowing repeated queries can allow a channel to map our
+            // history.
+            yield RECEIVE(get_address_, respond_get_address);
+
+            // TODO: pull active hosts from host cache (now resending self).
+            // TODO: need to distort for privacy, don't send connected peers.
+            if (self_.addresses.empty())
+                continue;
+
+            log::debug(LOG_PROTOCOL)
+                << "Sending addresses to [" << authority() << "] ("
+                << self_.addresses.size() << ")";
+
+            SEND1(self_, handle_send_address, _1);
+        }
+    }
 }
 
 void protocol_address::handle_send_address(const code& ec)
@@ -170,3 +186,5 @@ void protocol_address::handle_store_addresses(const code& ec)
 
 } // namespace network
 } // namespace libbitcoin
+
+#include <boost/asio/unyield.hpp>
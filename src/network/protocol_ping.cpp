@@ -31,6 +31,8 @@
 #include <bitcoin/bitcoin/utility/random.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
+#include <boost/asio/yield.hpp>
+
 INITIALIZE_TRACK(bc::network::protocol_ping);
 
 namespace libbitcoin {
@@ -45,6 +47,7 @@ using std::placeholders::_2;
 
 protocol_ping::protocol_ping(threadpool& pool, p2p&, channel::ptr channel)
   : protocol_timer(pool, channel, NAME),
+    ping_(nullptr),
     CONSTRUCT_TRACK(protocol_ping, LOG_PROTOCOL)
 {
 }
@@ -54,7 +57,8 @@ void protocol_ping::start(const settings& settings)
     protocol_timer::start(settings.channel_heartbeat(),
         BIND1(send_ping, _1));
 
-    SUBSCRIBE2(ping, handle_receive_ping, _1, _2);
+    // Start the ping responder coroutine.
+    respond_ping(error::success);
 
     // Send initial ping message by simulating first heartbeat.
     set_event(error::success);
@@ -75,14 +79,14 @@ void protocol_ping::send_ping(const code& ec)
         return;
     }
 
-    const auto nonce = pseudo_random();
+    const auto nonce = secure_random();
 
     SUBSCRIBE3(pong, handle_receive_pong, _1, _2, nonce);
     SEND1(ping(nonce), handle_send_ping, _1);
 }
 
-void protocol_ping::handle_receive_ping(const code& ec,
-    const message::ping& message)
+// This is resumed by each ping received, and answers it with a pong.
+void protocol_ping::respond_ping(const code& ec)
 {
     if (stopped())
         return;
@@ -96,9 +100,14 @@ void protocol_ping::handle_receive_ping(const code& ec,
         return;
     }
 
-    // Resubscribe to ping messages.
-    SUBSCRIBE2(ping, handle_receive_ping, _1, _2);
-    SEND1(pong(message.nonce), handle_send_pong, _1);
+    reenter(responder_)
+    {
+        for (;;)
+        {
+            yield RECEIVE(ping_, respond_ping);
+            SEND1(pong(ping_->nonce), handle_send_pong, _1);
+        }
+    }
 }
 
 void protocol_ping::handle_receive_pong(const code& ec,
@@ -160,3 +169,5 @@ void protocol_ping::handle_send_pong(const code& ec)
 
 } // namespace network
 } // namespace libbitcoin
+
+#include <boost/asio/unyield.hpp>
@@ -19,26 +19,31 @@
  */
 #include <bitcoin/bitcoin/network/proxy.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <memory>
+#include <utility>
 #include <boost/date_time.hpp>
 #include <boost/format.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/config/authority.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/messages.hpp>
 #include <bitcoin/bitcoin/network/asio.hpp>
 #include <bitcoin/bitcoin/network/message_subscriber.hpp>
 #include <bitcoin/bitcoin/network/shared_const_buffer.hpp>
+#include <bitcoin/bitcoin/network/trace.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/deadline.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/instrument.hpp>
 #include <bitcoin/bitcoin/utility/log.hpp>
 #include <bitcoin/bitcoin/utility/random.hpp>
 #include <bitcoin/bitcoin/utility/dispatcher.hpp>
@@ -60,6 +65,9 @@ using boost::posix_time::time_duration;
 // TODO: this is made-up, configure payload size guard for DoS protection.
 static constexpr size_t max_payload_size = 10 * 1024 * 1024;
 
+BC_METRIC(read_payload_metric, "proxy.read_payload", histogram);
+BC_METRIC(payload_bytes_metric, "proxy.payload_bytes", counter);
+
 // Cache the address for logging after stop.
 config::authority proxy::authority_factory(asio::socket_ptr socket)
 {
@@ -129,7 +137,7 @@ void proxy::subscribe_stop(result_handler handler)
     if (stopped())
         handler(error::channel_stopped);
     else
-        stop_subscriber_->subscribe(handler);
+        stop_subscriber_->subscribe(std::move(handler));
 }
 
 void proxy::do_stop(const code& ec)
@@ -140,6 +148,9 @@ void proxy::do_stop(const code& ec)
     stopped_ = true;
     handle_stopping();
 
+    if (trace::enabled())
+        trace::record(trace_event::channel_stopped, authority(), "", 0);
+
     // Close the socket, ignore the error code.
     boost_code ignore;
     socket_->shutdown(asio::socket::shutdown_both, ignore);
@@ -222,6 +233,9 @@ void proxy::handle_read_heading(const boost_code& ec, size_t)
 void proxy::handle_read_payload(const boost_code& ec, size_t,
     const heading& heading)
 {
+    BC_INSTRUMENT_SCOPE(read_payload_metric);
+    BC_INSTRUMENT_RECORD(payload_bytes_metric, heading.payload_size);
+
     if (stopped())
         return;
 
@@ -245,10 +259,18 @@ void proxy::handle_read_payload(const boost_code& ec, size_t,
     handle_activity();
 
     // Parse and publish the payload to message subscribers.
+    const auto tracing = trace::enabled();
+    const auto started = tracing ? trace::ticks() : 0;
     payload_source source(payload_copy);
     payload_stream istream(source);
     const auto error = message_subscriber_.load(heading.type(), istream);
 
+    if (tracing)
+        trace::record(trace_event::message_received, authority(),
+            heading.command, heading.payload_size,
+            static_cast<uint32_t>(std::min(trace::ticks() - started,
+                static_cast<uint64_t>(max_uint32))));
+
     // Warn about unconsumed bytes in the stream.
     if (!error && istream.peek() != std::istream::traits_type::eof())
         log::warning(LOG_NETWORK)
@@ -289,13 +311,18 @@ void proxy::do_send(const data_chunk& message, result_handler handler,
         << "Send " << command << " [" << authority() << "] ("
         << message.size() << " bytes)";
 
+    if (trace::enabled())
+        trace::record(trace_event::message_sent, authority(), command,
+            message.size() - heading::serialized_size());
+
     const shared_const_buffer buffer(message);
     async_write(*socket_, buffer,
         std::bind(&proxy::call_handle_send,
-            shared_from_this(), _1, handler));
+            shared_from_this(), _1, std::move(handler)));
 }
 
-void proxy::call_handle_send(const boost_code& ec, result_handler handler)
+void proxy::call_handle_send(const boost_code& ec,
+    const result_handler& handler)
 {
     handler(error::boost_to_error_code(ec));
 }
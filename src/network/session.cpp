@@ -172,7 +172,7 @@ void session::register_channel(channel::ptr channel,
         return;
     }
 
-    channel->set_nonce(nonzero_pseudo_random());
+    channel->set_nonce(nonzero_secure_random());
 
     const auto unpend_handler =
         dispatch_.ordered_delegate(&session::unpend,
@@ -0,0 +1,408 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/network/trace.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <bitcoin/bitcoin/config/authority.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+#include <bitcoin/bitcoin/utility/ring_buffer.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using boost::filesystem::path;
+using boost::iostreams::mapped_file;
+using boost::iostreams::mapped_file_params;
+
+// A trace file is a header followed by capacity records. The header is the
+// magic, the record size, the capacity and the number of records written.
+static BC_CONSTEXPR size_t magic_size = 8;
+static const byte_array<magic_size> trace_magic{ { 'b', 'c', 't', 'r', 'a',
+    'c', 'e', '1' } };
+static BC_CONSTEXPR size_t header_size = 32;
+
+// The records each queue holds between flushes.
+static BC_CONSTEXPR size_t queue_capacity = 4096;
+
+// Queued records are written to the file at this interval.
+static const auto flush_interval = std::chrono::milliseconds(100);
+
+static void write_record(uint8_t* out, const trace_record& record)
+{
+    auto serial = make_serializer(out);
+    serial.write_8_bytes_little_endian(record.timestamp);
+    serial.write_4_bytes_little_endian(record.duration);
+    serial.write_4_bytes_little_endian(record.payload_size);
+    serial.write_byte(static_cast<uint8_t>(record.event));
+    serial.write_byte(0x00);
+    serial.write_2_bytes_little_endian(record.port);
+    serial.write_data(record.ip);
+    serial.write_data(record.command);
+}
+
+static trace_record read_record(const uint8_t* in)
+{
+    auto deserial = make_deserializer_unsafe(in);
+    trace_record record;
+    record.timestamp = deserial.read_8_bytes_little_endian();
+    record.duration = deserial.read_4_bytes_little_endian();
+    record.payload_size = deserial.read_4_bytes_little_endian();
+    record.event = static_cast<trace_event>(deserial.read_byte());
+    deserial.read_byte();
+    record.port = deserial.read_2_bytes_little_endian();
+    record.ip = deserial.read_bytes<sizeof(message::ip_address)>();
+    record.command = deserial.read_bytes<trace_record::command_size>();
+    return record;
+}
+
+// Copies queued records into the memory-mapped trace file.
+class trace_writer
+{
+public:
+    trace_writer()
+      : running_(false), stopping_(false), producers_(0), dropped_(0),
+        capacity_(0), written_(0)
+    {
+    }
+
+    ~trace_writer()
+    {
+        stop();
+    }
+
+    bool running() const
+    {
+        return running_;
+    }
+
+    size_t dropped() const
+    {
+        return dropped_;
+    }
+
+    bool start(const path& path, size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(control_mutex_);
+
+        if (running_ || capacity == 0)
+            return false;
+
+        mapped_file_params params(path.string());
+        params.flags = mapped_file::readwrite;
+        params.new_file_size = header_size +
+            capacity * trace_record::serialized_size;
+
+        try
+        {
+            file_.open(params);
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+
+        if (!file_.is_open())
+            return false;
+
+        capacity_ = capacity;
+        written_ = 0;
+        write_header();
+
+        // A queue for each core, so that threads rarely share a queue.
+        const size_t queues = std::max(std::thread::hardware_concurrency(),
+            1u);
+
+        queues_.clear();
+        for (size_t queue = 0; queue < queues; ++queue)
+            queues_.emplace_back(new ring_buffer<trace_record>(
+                queue_capacity));
+
+        stopping_ = false;
+        thread_ = std::thread(std::bind(&trace_writer::run, this));
+        running_ = true;
+        return true;
+    }
+
+    void stop()
+    {
+        std::lock_guard<std::mutex> lock(control_mutex_);
+
+        if (!running_)
+            return;
+
+        // New records are dropped, queued records are written.
+        running_ = false;
+        while (producers_ > 0)
+            std::this_thread::yield();
+
+        if (true)
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            stopping_ = true;
+            wake_.notify_one();
+        }
+
+        thread_.join();
+        file_.close();
+    }
+
+    void push(trace_record&& record)
+    {
+        ++producers_;
+
+        if (running_)
+        {
+            const auto id = std::hash<std::thread::id>()(
+                std::this_thread::get_id());
+
+            if (!queues_[id % queues_.size()]->push(std::move(record)))
+                ++dropped_;
+        }
+
+        --producers_;
+    }
+
+private:
+    void write_header()
+    {
+        auto serial = make_serializer(
+            reinterpret_cast<uint8_t*>(file_.data()));
+        serial.write_data(trace_magic);
+        serial.write_4_bytes_little_endian(trace_record::serialized_size);
+        serial.write_4_bytes_little_endian(0);
+        serial.write_8_bytes_little_endian(capacity_);
+        serial.write_8_bytes_little_endian(written_);
+    }
+
+    void drain()
+    {
+        const auto records = reinterpret_cast<uint8_t*>(file_.data()) +
+            header_size;
+
+        trace_record record;
+        for (const auto& queue: queues_)
+        {
+            while (queue->pop(record))
+            {
+                const auto slot = written_++ % capacity_;
+                write_record(records + slot * trace_record::serialized_size,
+                    record);
+            }
+        }
+
+        write_header();
+    }
+
+    void run()
+    {
+        while (true)
+        {
+            const bool stopping = stopping_;
+            drain();
+
+            if (stopping)
+                return;
+
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            if (!stopping_)
+                wake_.wait_for(lock, flush_interval);
+        }
+    }
+
+    std::vector<std::unique_ptr<ring_buffer<trace_record>>> queues_;
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> stopping_;
+    std::atomic<size_t> producers_;
+    std::atomic<size_t> dropped_;
+    mapped_file file_;
+    uint64_t capacity_;
+    uint64_t written_;
+    std::mutex control_mutex_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+};
+
+static trace_writer writer;
+
+trace_record trace_record::factory_from_data(const data_chunk& data)
+{
+    BITCOIN_ASSERT(data.size() >= serialized_size);
+    return read_record(data.data());
+}
+
+data_chunk trace_record::to_data() const
+{
+    data_chunk data(serialized_size);
+    write_record(data.data(), *this);
+    return data;
+}
+
+bool trace::start(const path& path, size_t capacity)
+{
+    return writer.start(path, capacity);
+}
+
+void trace::stop()
+{
+    writer.stop();
+}
+
+bool trace::enabled()
+{
+    return writer.running();
+}
+
+size_t trace::dropped()
+{
+    return writer.dropped();
+}
+
+uint64_t trace::now()
+{
+    using namespace std::chrono;
+    const auto elapsed = system_clock::now().time_since_epoch();
+    return duration_cast<microseconds>(elapsed).count();
+}
+
+// The wall clock may be stepped backwards, the steady clock is not.
+uint64_t trace::ticks()
+{
+    using namespace std::chrono;
+    const auto elapsed = steady_clock::now().time_since_epoch();
+    return duration_cast<microseconds>(elapsed).count();
+}
+
+void trace::record(trace_event event, const config::authority& authority,
+    const std::string& command, size_t payload_size, uint32_t duration)
+{
+    if (!writer.running())
+        return;
+
+    trace_record record;
+    record.timestamp = now();
+    record.duration = duration;
+    record.payload_size = static_cast<uint32_t>(std::min(payload_size,
+        static_cast<size_t>(max_uint32)));
+    record.event = event;
+    record.port = authority.port();
+    record.ip = authority.ip();
+
+    // The command is truncated or zero padded to the wire size.
+    record.command.fill(0x00);
+    std::copy_n(command.begin(), std::min(command.size(),
+        record.command.size()), record.command.begin());
+
+    writer.push(std::move(record));
+}
+
+bool trace::read(list& out, const path& path)
+{
+    boost::filesystem::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+
+    data_chunk header(header_size);
+    file.read(reinterpret_cast<char*>(header.data()), header.size());
+    if (!file)
+        return false;
+
+    auto deserial = make_deserializer_unsafe(header.begin());
+    const auto magic = deserial.read_bytes<magic_size>();
+    const auto record_size = deserial.read_4_bytes_little_endian();
+    deserial.read_4_bytes_little_endian();
+    const auto capacity = deserial.read_8_bytes_little_endian();
+    const auto written = deserial.read_8_bytes_little_endian();
+
+    if (magic != trace_magic || capacity == 0 ||
+        record_size != trace_record::serialized_size)
+        return false;
+
+    // The header is not trusted, the file must be exactly the size it claims.
+    boost::system::error_code ec;
+    const auto file_size = boost::filesystem::file_size(path, ec);
+    if (ec || capacity > (max_uint64 - header_size) / record_size ||
+        file_size != header_size + capacity * record_size)
+        return false;
+
+    // Once the file is full the oldest record follows the newest.
+    const auto count = static_cast<size_t>(std::min(written, capacity));
+    const auto first = static_cast<size_t>(written % capacity);
+    data_chunk records(count * record_size);
+    file.read(reinterpret_cast<char*>(records.data()), records.size());
+    if (!file)
+        return false;
+
+    out.clear();
+    out.reserve(count);
+    for (size_t index = 0; index < count; ++index)
+    {
+        const auto slot = written > capacity ? (first + index) % count :
+            index;
+        out.push_back(read_record(records.data() + slot * record_size));
+    }
+
+    // Records of different threads are interleaved within each flush.
+    std::stable_sort(out.begin(), out.end(),
+        [](const trace_record& left, const trace_record& right)
+        {
+            return left.timestamp < right.timestamp;
+        });
+
+    return true;
+}
+
+std::string trace::to_text(trace_event event)
+{
+    switch (event)
+    {
+        case trace_event::message_received:
+            return "RECEIVED";
+        case trace_event::message_sent:
+            return "SENT";
+        case trace_event::channel_stopped:
+            return "STOPPED";
+        default:
+            return "";
+    }
+}
+
+} // namespace network
+} // namespace libbitcoin
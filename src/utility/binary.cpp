@@ -19,6 +19,9 @@
  */
 #include <bitcoin/bitcoin/utility/binary.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <sstream>
 #include <bitcoin/bitcoin/constants.hpp>
@@ -27,6 +30,81 @@
 
 namespace libbitcoin {
 
+// Blocks are processed as big endian words, with missing blocks read as zero.
+static BC_CONSTEXPR size_t word_blocks = sizeof(uint64_t);
+static BC_CONSTEXPR size_t word_bits = word_blocks * byte_bits;
+
+static uint8_t read_block(const data_chunk& blocks, size_t index)
+{
+    return index < blocks.size() ? blocks[index] : 0x00;
+}
+
+static uint64_t read_word(const data_chunk& blocks, size_t index)
+{
+    if (index < blocks.size() && blocks.size() - index >= word_blocks)
+        return from_big_endian_unsafe<uint64_t>(blocks.begin() + index);
+
+    uint64_t word = 0;
+    for (size_t block = 0; block < word_blocks; ++block)
+        word = (word << byte_bits) | read_block(blocks, index + block);
+
+    return word;
+}
+
+// Write the leading blocks of the word that fall within the blocks.
+static void write_word(data_chunk& blocks, size_t index, uint64_t word)
+{
+    const auto count = std::min(word_blocks, blocks.size() - index);
+    for (size_t block = 0; block < count; ++block)
+        blocks[index + block] = static_cast<uint8_t>(word >>
+            (word_bits - byte_bits * (block + 1)));
+}
+
+// Fill count blocks of to with the bits of from, starting at bit distance.
+// The blocks may be the same, since each word is read before it is written.
+static void copy_left(data_chunk& to, size_t count, const data_chunk& from,
+    size_t distance)
+{
+    const auto block_offset = distance / byte_bits;
+    const auto offset = distance % byte_bits;
+
+    for (size_t index = 0; index < count; index += word_blocks)
+    {
+        const auto source = block_offset + index;
+        auto word = read_word(from, source) << offset;
+
+        if (offset != 0)
+            word |= read_block(from, source + word_blocks) >>
+                (byte_bits - offset);
+
+        write_word(to, index, word);
+    }
+}
+
+// True if the leading bits of left match those of right, padded with zeros.
+static bool is_prefix_equal(const uint8_t* left, size_t bits,
+    const uint8_t* right, size_t right_size)
+{
+    const auto full_blocks = bits / byte_bits;
+    const auto common = std::min(full_blocks, right_size);
+
+    if (!std::equal(left, left + common, right))
+        return false;
+
+    for (auto block = common; block < full_blocks; ++block)
+        if (left[block] != 0x00)
+            return false;
+
+    const auto remainder = bits % byte_bits;
+
+    if (remainder == 0)
+        return true;
+
+    const auto mask = static_cast<uint8_t>(0xFF << (byte_bits - remainder));
+    const uint8_t next = full_blocks < right_size ? right[full_blocks] : 0x00;
+    return ((left[full_blocks] ^ next) & mask) == 0;
+}
+
 binary_type::size_type binary_type::blocks_size(const size_type bitsize)
 {
     return bitsize == 0 ? 0 : (bitsize - 1) / bits_per_block + 1;
@@ -100,95 +178,112 @@ binary_type::size_type binary_type::size() const
 
 void binary_type::append(const binary_type& post)
 {
+    if (&post == this)
+    {
+        append(binary_type(post));
+        return;
+    }
+
     const size_type block_offset = size() / bits_per_block;
     const size_type offset = size() % bits_per_block;
 
-    // overkill for byte alignment
-    binary_type duplicate(post.size(), post.blocks());
-    duplicate.shift_right(offset);
-
+    // Excess bits are zero, so the shifted post blocks can be merged in.
     resize(size() + post.size());
-    data_chunk post_shift_blocks = duplicate.blocks();
-    for (size_type i = 0; i < post_shift_blocks.size(); i++)
+    const auto& post_blocks = post.blocks();
+
+    for (size_type i = 0; i < post_blocks.size(); ++i)
     {
-        blocks_[block_offset + i] = blocks_[block_offset + i] | post_shift_blocks[i];
+        const auto block = post_blocks[i];
+        blocks_[block_offset + i] |= block >> offset;
+
+        if (offset != 0 && block_offset + i + 1 < blocks_.size())
+            blocks_[block_offset + i + 1] |= static_cast<uint8_t>(block <<
+                (bits_per_block - offset));
     }
 }
 
 void binary_type::prepend(const binary_type& prior)
 {
-    shift_right(prior.size());
-    data_chunk prior_blocks = prior.blocks();
-    for (size_type i = 0; i < prior_blocks.size(); i++)
+    if (&prior == this)
     {
-        blocks_[i] = blocks_[i] | prior_blocks[i];
+        prepend(binary_type(prior));
+        return;
     }
+
+    shift_right(prior.size());
+    const auto& prior_blocks = prior.blocks();
+
+    for (size_type i = 0; i < prior_blocks.size(); ++i)
+        blocks_[i] |= prior_blocks[i];
 }
 
 void binary_type::shift_left(size_type distance)
 {
     const size_type initial_size = size();
-    const size_type initial_block_count = blocks_.size();
-    size_type destination_size = 0;
-    if (distance < initial_size)
-        destination_size = initial_size - distance;
+    const size_type destination_size = distance < initial_size ?
+        initial_size - distance : 0;
 
+    // Only the blocks that survive the resize are computed.
+    copy_left(blocks_, blocks_size(destination_size), blocks_, distance);
+    resize(destination_size);
+}
+
+void binary_type::shift_right(size_type distance)
+{
+    const size_type destination_size = size() + distance;
     const size_type block_offset = distance / bits_per_block;
     const size_type offset = distance % bits_per_block;
 
-    // shift
-    for (size_type i = 0; i < initial_block_count; i++)
+    // Blocks are moved from the end down, so each source is read before it
+    // is overwritten. Growth is zero filled and excess bits are zero.
+    blocks_.resize(blocks_size(destination_size), 0x00);
+    const auto count = blocks_.size();
+
+    for (auto end = count; end > 0;)
     {
-        uint8_t leading_bits = 0x00;
-        uint8_t trailing_bits = 0x00;
+        const auto index = end > word_blocks ? end - word_blocks : 0;
+        const auto last = end;
+        end = index;
 
-        if ((offset != 0) && ((block_offset + i + 1) < initial_block_count))
+        if (index > block_offset)
         {
-            trailing_bits = blocks_[block_offset + i + 1] >> (bits_per_block - offset);
+            const auto source = index - block_offset;
+            auto word = read_word(blocks_, source) >> offset;
+
+            if (offset != 0)
+                word |= static_cast<uint64_t>(blocks_[source - 1]) <<
+                    (word_bits - offset);
+
+            write_word(blocks_, index, word);
+            continue;
         }
 
-        if ((block_offset + i) < initial_block_count)
+        // Blocks near the front may draw on the zero fill before the data.
+        for (auto block = last; block > index; --block)
         {
-            leading_bits = blocks_[block_offset + i] << offset;
+            const auto target = block - 1;
+            const uint8_t high = target >= block_offset ?
+                blocks_[target - block_offset] : 0x00;
+            const uint8_t low = offset != 0 && target > block_offset ?
+                blocks_[target - block_offset - 1] : 0x00;
+
+            blocks_[target] = static_cast<uint8_t>((high >> offset) |
+                (low << (bits_per_block - offset)));
         }
-
-        blocks_[i] = leading_bits | trailing_bits;
     }
 
     resize(destination_size);
 }
 
-void binary_type::shift_right(size_type distance)
+binary_type binary_type::substring(size_type start, size_type length) const
 {
-    const size_type initial_size = size();
-    const size_type initial_block_count = blocks_.size();
-    const size_type offset = distance % bits_per_block;
-    const size_type offset_blocks = distance / bits_per_block;
-    const size_type destination_size = initial_size + distance;
-    for (size_type i = 0; i < offset_blocks; i++)
-    {
-        blocks_.insert(blocks_.begin(), 0x00);
-    }
-
-    uint8_t previous = 0x00;
-    for (size_type i = 0; i < initial_block_count; i++)
-    {
-        uint8_t current = blocks_[offset_blocks + i];
-        uint8_t leading_bits = previous << (bits_per_block - offset);
-        uint8_t trailing_bits = current >> offset;
-        blocks_[offset_blocks + i] = leading_bits | trailing_bits;
-        previous = current;
-    }
-
-    resize(destination_size);
-
-    if (offset_blocks + initial_block_count < blocks_.size())
-    {
-        blocks_[blocks_.size() - 1] = previous << (bits_per_block - offset);
-    }
+    binary_type result;
+    substring(result, start, length);
+    return result;
 }
 
-binary_type binary_type::substring(size_type start, size_type length) const
+void binary_type::substring(binary_type& out, size_type start,
+    size_type length) const
 {
     size_type current_size = size();
     if (start > current_size)
@@ -201,15 +296,23 @@ binary_type binary_type::substring(size_type start, size_type length) const
         length = current_size - start;
     }
 
-    binary_type result(current_size, blocks_);
-    result.shift_left(start);
-    result.resize(length);
-    return result;
+    if (&out == this)
+    {
+        out.shift_left(start);
+        out.resize(length);
+        return;
+    }
+
+    // Reuses the capacity of the out blocks.
+    out.blocks_.resize(blocks_size(length));
+    copy_left(out.blocks_, out.blocks_.size(), blocks_, start);
+    out.resize(length);
 }
 
 bool binary_type::is_prefix_of(const uint32_t field) const
 {
-    return is_prefix_of(to_little_endian(field));
+    const auto bytes = to_little_endian(field);
+    return is_prefix_equal(blocks_.data(), size(), bytes.data(), bytes.size());
 }
 
 bool binary_type::is_prefix_of(const binary_type& field) const
@@ -219,18 +322,14 @@ bool binary_type::is_prefix_of(const binary_type& field) const
 
 bool binary_type::is_prefix_of(data_slice field) const
 {
-    const binary_type truncated_prefix(size(), field);
-    return *this == truncated_prefix;
+    return is_prefix_equal(blocks_.data(), size(), field.data(), field.size());
 }
 
 bool binary_type::operator==(const binary_type& other) const
 {
-    using size_type = binary_type::size_type;
-    for (size_type i = 0; i < size() && i < other.size(); ++i)
-        if ((*this)[i] != other[i])
-            return false;
-
-    return true;
+    const auto bits = std::min(size(), other.size());
+    return is_prefix_equal(blocks_.data(), bits, other.blocks_.data(),
+        other.blocks_.size());
 }
 
 bool binary_type::operator!=(const binary_type& other) const
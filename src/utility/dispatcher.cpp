@@ -21,13 +21,27 @@
 
 #include <new>
 #include <thread>
+#include <utility>
+#include <bitcoin/bitcoin/utility/scheduler.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
 
 dispatcher::dispatcher(threadpool& pool)
-  : service_(pool.service()), strand_(service_)
+  : service_(pool.service()), strand_(service_), scheduler_(nullptr)
 {
 }
 
+dispatcher::dispatcher(threadpool& pool, scheduler& executor)
+  : service_(pool.service()), strand_(service_), scheduler_(&executor)
+{
+}
+
+// The scheduler does not take the job if it refuses it, so it can be posted.
+void dispatcher::schedule(scheduler::task&& job, task_priority priority)
+{
+    if (!scheduler_->post(std::move(job), priority))
+        service_.post(std::move(job));
+}
+
 } // namespace libbitcoin
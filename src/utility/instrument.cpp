@@ -0,0 +1,240 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/instrument.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/network/asio.hpp>
+#include <bitcoin/bitcoin/utility/deadline.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+using std::placeholders::_1;
+
+// Constant (zero) initialization precedes all dynamic initialization, so
+// metrics may register from any translation unit in any order.
+metric* metric::first_ = nullptr;
+
+static size_t bucket_index(uint64_t value)
+{
+    size_t index = 0;
+    for (; value != 0 && index < metric::bucket_count - 1; ++index)
+        value >>= 1;
+
+    return index;
+}
+
+static size_t shard_index()
+{
+    const auto id = std::this_thread::get_id();
+    return std::hash<std::thread::id>()(id) % metric::shard_count;
+}
+
+// metric_snapshot
+// ----------------------------------------------------------------------------
+
+double metric_snapshot::mean() const
+{
+    return count == 0 ? 0.0 : static_cast<double>(sum) / count;
+}
+
+uint64_t metric_snapshot::percentile(double fraction) const
+{
+    if (count == 0)
+        return 0;
+
+    const auto target = static_cast<uint64_t>(fraction * count);
+    uint64_t total = 0;
+
+    for (size_t index = 0; index < buckets.size(); ++index)
+    {
+        total += buckets[index];
+
+        if (total > target || total == count)
+            return index == 0 ? 0 : (uint64_t(1) << index) - 1;
+    }
+
+    return 0;
+}
+
+// metric
+// ----------------------------------------------------------------------------
+
+metric* metric::first()
+{
+    return first_;
+}
+
+// Shards are zero by static initialization, a record may precede this.
+metric::metric(const char* name, metric_kind kind)
+  : name_(name), kind_(kind), next_(first_)
+{
+    first_ = this;
+}
+
+void metric::record(uint64_t value)
+{
+    auto& shard = shards_[shard_index()];
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+
+    if (kind_ == metric_kind::histogram)
+        shard.buckets[bucket_index(value)].fetch_add(1,
+            std::memory_order_relaxed);
+}
+
+void metric::reset()
+{
+    for (auto& shard: shards_)
+    {
+        shard.count.store(0, std::memory_order_relaxed);
+        shard.sum.store(0, std::memory_order_relaxed);
+
+        for (auto& bucket: shard.buckets)
+            bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+const char* metric::name() const
+{
+    return name_;
+}
+
+metric_kind metric::kind() const
+{
+    return kind_;
+}
+
+metric* metric::next() const
+{
+    return next_;
+}
+
+metric_snapshot metric::snapshot() const
+{
+    metric_snapshot out{ name_, kind_, 0, 0, {} };
+
+    if (kind_ == metric_kind::histogram)
+        out.buckets.resize(bucket_count, 0);
+
+    for (const auto& shard: shards_)
+    {
+        out.count += shard.count.load(std::memory_order_relaxed);
+        out.sum += shard.sum.load(std::memory_order_relaxed);
+
+        for (size_t index = 0; index < out.buckets.size(); ++index)
+            out.buckets[index] += shard.buckets[index].load(
+                std::memory_order_relaxed);
+    }
+
+    return out;
+}
+
+// scoped_timer
+// ----------------------------------------------------------------------------
+
+scoped_timer::scoped_timer(metric& target)
+  : metric_(target), start_(clock::now())
+{
+}
+
+scoped_timer::~scoped_timer()
+{
+    const auto elapsed = std::chrono::duration_cast<
+        std::chrono::nanoseconds>(clock::now() - start_);
+    metric_.record(static_cast<uint64_t>(elapsed.count()));
+}
+
+// instrument
+// ----------------------------------------------------------------------------
+
+instrument::snapshots instrument::snapshot()
+{
+    snapshots out;
+    for (auto it = metric::first(); it != nullptr; it = it->next())
+        out.push_back(it->snapshot());
+
+    return out;
+}
+
+void instrument::reset()
+{
+    for (auto it = metric::first(); it != nullptr; it = it->next())
+        it->reset();
+}
+
+instrument::instrument(threadpool& pool, const asio::duration& period,
+    bool clear)
+  : clear_(clear), stopped_(true),
+    timer_(std::make_shared<deadline>(pool, period))
+{
+}
+
+void instrument::start(handler handle)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = false;
+    timer_->start(
+        std::bind(&instrument::handle_timer,
+            shared_from_this(), _1, handle));
+}
+
+void instrument::stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+    timer_->cancel();
+}
+
+// The handler is invoked outside of the lock so that it may call stop.
+void instrument::handle_timer(const code& ec, handler handle)
+{
+    if (ec)
+        return;
+
+    if (true)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (stopped_)
+            return;
+    }
+
+    handle(snapshot());
+
+    if (clear_)
+        reset();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (stopped_)
+        return;
+
+    timer_->start(
+        std::bind(&instrument::handle_timer,
+            shared_from_this(), _1, handle));
+}
+
+} // namespace libbitcoin
@@ -19,46 +19,303 @@
  */
 #include <bitcoin/bitcoin/utility/log.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include <utility>
 #include <sstream>
 #include <string>
 #include <boost/date_time.hpp>
 #include <boost/format.hpp>
 #include <bitcoin/bitcoin/unicode/unicode.hpp>
+#include <bitcoin/bitcoin/utility/ring_buffer.hpp>
 
 namespace libbitcoin {
 
+// Define when building the library as the least level to format, for
+// example -DBC_LOG_MINIMUM=info (see configure --with-log-minimum).
+#ifndef BC_LOG_MINIMUM
+    #define BC_LOG_MINIMUM debug
+#endif
+
+// Lines below this level are never formatted or written.
+static BC_CONSTEXPR log::level compiled_minimum = log::level::BC_LOG_MINIMUM;
+
+static std::shared_ptr<log::functor> make_output(log::functor output)
+{
+    return std::make_shared<log::functor>(std::move(output));
+}
+
+// Debug lines are not formatted unless an output function is set.
+log::destinations log::destinations_
+{
+#ifdef DEBUG
+    std::make_pair(level::debug, make_output(output_cout)),
+#endif
+    std::make_pair(level::info, make_output(output_cout)),
+    std::make_pair(level::warning, make_output(output_cerr)),
+    std::make_pair(level::error, make_output(output_cerr)),
+    std::make_pair(level::fatal, make_output(output_cerr))
+};
+
+log::minimums log::minimums_;
+log::level log::minimum_ = level::debug;
+
+// The writer sleeps no longer than this with lines possibly queued.
+static const auto writer_interval = std::chrono::milliseconds(50);
+
+// A line queued for the writer, with the output function resolved.
+// The function is shared, so that it outlives a change of destination.
+struct log_line
+{
+    std::shared_ptr<log::functor> output;
+    log::level level;
+    std::string domain;
+    std::string body;
+};
+
+// Drains queued lines to their output functions on a background thread.
+class log_writer
+{
+public:
+    log_writer()
+      : running_(false), stopping_(false), sleeping_(false), producers_(0),
+        dropped_(0)
+    {
+    }
+
+    ~log_writer()
+    {
+        stop();
+    }
+
+    bool running() const
+    {
+        return running_;
+    }
+
+    size_t dropped() const
+    {
+        return dropped_;
+    }
+
+    void start(size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(control_mutex_);
+
+        if (running_)
+            return;
+
+        buffer_.reset(new ring_buffer<log_line>(capacity));
+        stopping_ = false;
+        thread_ = std::thread(std::bind(&log_writer::run, this));
+        running_ = true;
+    }
+
+    void stop()
+    {
+        std::lock_guard<std::mutex> lock(control_mutex_);
+
+        if (!running_)
+            return;
+
+        // New lines are written by their callers, queued lines are drained.
+        running_ = false;
+        while (producers_ > 0)
+            std::this_thread::yield();
+
+        if (true)
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            stopping_ = true;
+            wake_.notify_one();
+        }
+
+        thread_.join();
+    }
+
+    // False if the caller must write the line itself.
+    bool push(log_line&& line)
+    {
+        ++producers_;
+
+        if (!running_)
+        {
+            --producers_;
+            return false;
+        }
+
+        if (!buffer_->push(std::move(line)))
+            ++dropped_;
+
+        --producers_;
+
+        if (sleeping_)
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            wake_.notify_one();
+        }
+
+        return true;
+    }
+
+private:
+    bool drain()
+    {
+        log_line line;
+        auto wrote = false;
+
+        while (buffer_->pop(line))
+        {
+            (*line.output)(line.level, line.domain, line.body);
+            wrote = true;
+        }
+
+        // Console output is flushed once for each batch of lines.
+        if (wrote)
+        {
+            bc::cout.flush();
+            bc::cerr.flush();
+        }
+
+        return wrote;
+    }
+
+    void run()
+    {
+        while (true)
+        {
+            const bool stopping = stopping_;
+
+            if (drain())
+                continue;
+
+            if (stopping)
+                return;
+
+            // A line queued after the drain is seen by this one or notifies.
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            sleeping_ = true;
+
+            if (!drain() && !stopping_)
+                wake_.wait_for(lock, writer_interval);
+
+            sleeping_ = false;
+        }
+    }
+
+    std::unique_ptr<ring_buffer<log_line>> buffer_;
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> stopping_;
+    std::atomic<bool> sleeping_;
+    std::atomic<size_t> producers_;
+    std::atomic<size_t> dropped_;
+    std::mutex control_mutex_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+};
+
+// Destroyed (and so drained) before the destinations above.
+static log_writer writer;
+
+// The level is checked before anything is allocated.
 log::log(level value, const std::string& domain)
-  : level_(value), domain_(domain)
+  : level_(value), enabled_(enabled(value, domain))
 {
+    if (!enabled_)
+        return;
+
+    domain_ = domain;
+    stream_.reset(new std::ostringstream);
 }
 
-// g++ bug in initializer list.
-// It should be: stream_(std::move(other.stream_))
-// gcc.gnu.org/bugzilla/show_bug.cgi?id=54316
 log::log(log&& other)
   : level_(other.level_),
+    enabled_(other.enabled_),
     domain_(std::move(other.domain_)),
-    stream_(other.stream_.str())
+    stream_(std::move(other.stream_))
 {
+    // The line is written once, by this instance.
+    other.enabled_ = false;
 }
 
 log::~log()
 {
-    if (destinations_.count(level_) != 0)
-        destinations_[level_](level_, domain_, stream_.str());
+    if (!enabled_)
+        return;
+
+    // The destination may have been cleared since construction.
+    const auto it = destinations_.find(level_);
+    if (it == destinations_.end())
+        return;
+
+    const auto output = it->second;
+    const auto body = stream_->str();
+
+    // The caller writes the line if the background writer is stopped.
+    if (!writer.push({ output, level_, domain_, body }))
+        (*output)(level_, domain_, body);
 }
 
+// A replaced function is released once the writer drains its lines.
 void log::set_output_function(functor value)
 {
-    destinations_[level_] = value;
+    if (value)
+        destinations_[level_] = make_output(std::move(value));
+    else
+        destinations_.erase(level_);
+}
+
+log::functor log::output_function(level value)
+{
+    const auto it = destinations_.find(value);
+    return it == destinations_.end() ? functor() : *it->second;
 }
 
 void log::clear()
 {
     destinations_.clear();
+    minimums_.clear();
+    minimum_ = level::debug;
+}
+
+void log::set_minimum(level value, const std::string& domain)
+{
+    if (domain.empty())
+        minimum_ = value;
+    else
+        minimums_[domain] = value;
+}
+
+bool log::enabled(level value, const std::string& domain)
+{
+    if (value < compiled_minimum || destinations_.count(value) == 0)
+        return false;
+
+    const auto it = minimums_.find(domain);
+    return value >= (it == minimums_.end() ? minimum_ : it->second);
+}
+
+void log::start_writer(size_t capacity)
+{
+    writer.start(capacity);
+}
+
+void log::stop_writer()
+{
+    writer.stop();
+}
+
+size_t log::dropped()
+{
+    return writer.dropped();
 }
 
 log log::debug(const std::string& domain)
@@ -115,15 +372,14 @@ void log::to_stream(std::ostream& out, level value, const std::string& domain,
     if (!domain.empty())
         buffer << " [" << domain << "]";
 
-    buffer << ": " << body << std::endl;
+    buffer << ": " << body << "\n";
 
     // Buffering prevents line interleaving across threads.
     out << buffer.str();
-    out.flush();
-}
 
-void log::output_ignore(level, const std::string&, const std::string&)
-{
+    // The background writer flushes once for each batch of lines.
+    if (!writer.running())
+        out.flush();
 }
 
 void log::output_cout(level value, const std::string& domain,
@@ -138,17 +394,4 @@ void log::output_cerr(level value, const std::string& domain,
     to_stream(bc::cerr, value, domain, body);
 }
 
-log::destinations log::destinations_
-{
-#ifdef DEBUG
-    std::make_pair(level::debug, output_cout),
-#else
-    std::make_pair(level::debug, output_ignore),
-#endif
-    std::make_pair(level::info, output_cout),
-    std::make_pair(level::warning, output_cerr),
-    std::make_pair(level::error, output_cerr),
-    std::make_pair(level::fatal, output_cerr)
-};
-
 } // namespace libbitcoin
@@ -19,9 +19,14 @@
  */
 #include <bitcoin/bitcoin/utility/random.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <stdexcept>
 #include <random>
+#include <thread>
 #include <boost/date_time.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
@@ -33,22 +38,121 @@ using namespace boost::posix_time;
 // DO NOT USE srand() and rand() on MSVC as srand must be called per thread.
 // As a result it is difficult to use safely.
 
-// Not fully testable due to lack of random engine injection.
-// This may be truly random depending on the underlying device.
-uint64_t pseudo_random()
+static uint64_t rotate_left(uint64_t value, int shift)
+{
+    return (value << shift) | (value >> (64 - shift));
+}
+
+uint64_t splitmix64(uint64_t& seed)
+{
+    seed += 0x9e3779b97f4a7c15;
+    auto mix = seed;
+    mix = (mix ^ (mix >> 30)) * 0xbf58476d1ce4e5b9;
+    mix = (mix ^ (mix >> 27)) * 0x94d049bb133111eb;
+    return mix ^ (mix >> 31);
+}
+
+static void expand(uint64_t (&state)[4], uint64_t seed)
+{
+    for (auto& word: state)
+        word = splitmix64(seed);
+}
+
+static uint64_t next(uint64_t (&state)[4])
+{
+    const auto result = rotate_left(state[1] * 5, 7) * 9;
+    const auto shifted = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= shifted;
+    state[3] = rotate_left(state[3], 45);
+    return result;
+}
+
+// xoshiro256
+// ----------------------------------------------------------------------------
+
+xoshiro256::xoshiro256(uint64_t seed)
+{
+    expand(state_, seed);
+}
+
+xoshiro256::result_type xoshiro256::operator()()
+{
+    return next(state_);
+}
+
+// Fill the whole state from the random device, so that it cannot be searched.
+// The all zero state is the one state that the generator cannot leave.
+static void seed(uint64_t (&state)[4])
 {
     std::random_device device;
-    std::uniform_int_distribution<uint64_t> distribution;
-    return distribution(device);
+
+    do
+    {
+        // The device produces 32 bit words.
+        for (auto& word: state)
+            word = (static_cast<uint64_t>(device()) << 32) | device();
+
+    } while ((state[0] | state[1] | state[2] | state[3]) == 0);
 }
 
-// Not fully testable due to lack of random engine injection.
-// This may be truly random depending on the underlying device.
-uint64_t nonzero_pseudo_random()
+// Shared generators.
+// ----------------------------------------------------------------------------
+// This avoids thread_local, which is unavailable on some supported compilers.
+// Threads map to shards by id, and each shard is seeded on its first use.
+// The shards are constant-initialized (unlocked and unseeded) before any
+// dynamic initialization, so these may be used during static initialization.
+
+struct generator_shard
+{
+    std::atomic_flag lock = ATOMIC_FLAG_INIT;
+    bool seeded = false;
+    uint64_t state[4] = {};
+};
+
+static BC_CONSTEXPR size_t generator_shards = 16;
+static generator_shard shards[generator_shards];
+
+static generator_shard& acquire_shard()
+{
+    const auto id = std::this_thread::get_id();
+    const auto index = std::hash<std::thread::id>()(id) % generator_shards;
+    auto& shard = shards[index];
+
+    while (shard.lock.test_and_set(std::memory_order_acquire))
+        std::this_thread::yield();
+
+    if (!shard.seeded)
+    {
+        seed(shard.state);
+        shard.seeded = true;
+    }
+
+    return shard;
+}
+
+static void release_shard(generator_shard& shard)
+{
+    shard.lock.clear(std::memory_order_release);
+}
+
+uint64_t pseudo_random()
+{
+    auto& shard = acquire_shard();
+    const auto value = next(shard.state);
+    release_shard(shard);
+    return value;
+}
+
+template <typename Generator>
+static uint64_t nonzero_random(Generator generator)
 {
     for (auto index = 0; index < 100; ++index)
     {
-        const auto value = pseudo_random();
+        const auto value = generator();
         if (value > 0)
             return value;
     }
@@ -57,21 +161,49 @@ uint64_t nonzero_pseudo_random()
     throw std::runtime_error("The RNG produces 100 consecutive zero values.");
 }
 
-// Not fully testable due to lack of random engine injection.
-// This may be truly random depending on the underlying device.
+uint64_t nonzero_pseudo_random()
+{
+    return nonzero_random(pseudo_random);
+}
+
+// The buffer may be used as a nonce or salt, so this remains on the device.
 void pseudo_random_fill(data_chunk& chunk)
+{
+    secure_random_fill(chunk);
+}
+
+// Secure randomness.
+// ----------------------------------------------------------------------------
+// The random device is the operating system entropy source on supported
+// platforms (/dev/urandom or the processor, and RtlGenRandom on Windows).
+
+uint64_t secure_random()
+{
+    std::random_device device;
+    std::uniform_int_distribution<uint64_t> distribution;
+    return distribution(device);
+}
+
+uint64_t nonzero_secure_random()
+{
+    return nonzero_random(secure_random);
+}
+
+void secure_random_fill(data_chunk& chunk)
 {
     std::random_device device;
-    std::uniform_int_distribution<uint16_t> distribution;
-    for (uint8_t& byte: chunk)
+
+    // The device produces 32 bit words, use all of the bytes of each.
+    for (size_t index = 0; index < chunk.size(); index += sizeof(uint32_t))
     {
-        // uniform_int_distribution is undefined for sizes < 16 bits,
-        // so we generate a 16 bit value and reduce it to 8 bits.
-        byte = distribution(device) % std::numeric_limits<uint8_t>::max();
+        auto value = static_cast<uint32_t>(device());
+        const auto end = std::min(chunk.size(), index + sizeof(uint32_t));
+
+        for (auto byte = index; byte < end; ++byte, value >>= 8)
+            chunk[byte] = static_cast<uint8_t>(value);
     }
 }
 
-// Not fully testable due to lack of random engine injection.
 // Randomly select a time duration in the range [expiration/ratio, expiration].
 time_duration pseudo_randomize(const time_duration& expiration, uint8_t ratio)
 {
@@ -0,0 +1,242 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/scheduler.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+
+// The number of tasks a worker runs between preferring external tasks.
+static BC_CONSTEXPR size_t injected_interval = 61;
+
+scheduler::scheduler(size_t number_threads, thread_priority priority,
+    bool pin)
+  : pending_(0),
+    sleeping_(0),
+    stopped_(false),
+    aborted_(false),
+    started_(false)
+{
+    if (number_threads == 0)
+        number_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for (size_t index = 0; index < number_threads; ++index)
+        queues_.emplace_back(new queue);
+
+    for (size_t index = 0; index < number_threads; ++index)
+    {
+        const auto action = [this, index, priority, pin]()
+        {
+            set_thread_priority(priority);
+
+            if (pin)
+                set_thread_affinity(index);
+
+            run(index);
+        };
+
+        threads_.push_back(std::thread(action));
+        workers_.push_back(threads_.back().get_id());
+    }
+
+    std::lock_guard<std::mutex> lock(start_mutex_);
+    started_ = true;
+    start_.notify_all();
+}
+
+scheduler::~scheduler()
+{
+    shutdown();
+    join();
+}
+
+size_t scheduler::size() const
+{
+    return queues_.size();
+}
+
+// The index of the calling worker, or the size if not a worker.
+size_t scheduler::current() const
+{
+    const auto id = std::this_thread::get_id();
+    const auto it = std::find(workers_.begin(), workers_.end(), id);
+    return static_cast<size_t>(it - workers_.begin());
+}
+
+bool scheduler::post(task&& job, task_priority priority)
+{
+    if (aborted_)
+        return false;
+
+    // Workers keep their own tasks local, others are queued in order.
+    const auto index = current();
+    const auto worker = index != queues_.size();
+
+    // Counted first, so that a worker never sees a task it cannot count.
+    // A worker cannot exit while counted, so a worker may post as it drains.
+    // Others are refused once stopped, as the workers may already be gone.
+    ++pending_;
+
+    if (!worker && stopped_)
+    {
+        --pending_;
+        return false;
+    }
+
+    auto& target = worker ? *queues_[index] : injected_;
+
+    if (true)
+    {
+        std::lock_guard<std::mutex> lock(target.mutex);
+        auto& tasks = priority == task_priority::high ? target.high :
+            target.normal;
+        tasks.push_back(std::move(job));
+    }
+
+    if (sleeping_ > 0)
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        idle_.notify_one();
+    }
+
+    return true;
+}
+
+// The owner takes its most recent task, which is likely still in cache.
+bool scheduler::pop(size_t index, task& out)
+{
+    auto& source = *queues_[index];
+    std::lock_guard<std::mutex> lock(source.mutex);
+    auto& tasks = source.high.empty() ? source.normal : source.high;
+
+    if (tasks.empty())
+        return false;
+
+    out = std::move(tasks.back());
+    tasks.pop_back();
+    return true;
+}
+
+bool scheduler::take_oldest(queue& source, task& out)
+{
+    std::lock_guard<std::mutex> lock(source.mutex);
+    auto& tasks = source.high.empty() ? source.normal : source.high;
+
+    if (tasks.empty())
+        return false;
+
+    out = std::move(tasks.front());
+    tasks.pop_front();
+    return true;
+}
+
+// External tasks are taken oldest first, so that later posts cannot bury one.
+bool scheduler::pop_injected(task& out)
+{
+    return take_oldest(injected_, out);
+}
+
+// A thief takes the oldest task of the first other worker that has one.
+bool scheduler::steal(size_t thief, task& out)
+{
+    const auto count = queues_.size();
+
+    for (size_t offset = 1; offset < count; ++offset)
+        if (take_oldest(*queues_[(thief + offset) % count], out))
+            return true;
+
+    return false;
+}
+
+void scheduler::run(size_t index)
+{
+    if (true)
+    {
+        std::unique_lock<std::mutex> lock(start_mutex_);
+        start_.wait(lock, [this]() { return started_; });
+    }
+
+    size_t runs = 0;
+
+    while (!aborted_)
+    {
+        // External tasks are periodically preferred, so that a worker that
+        // keeps posting to itself cannot starve them.
+        task job;
+        const auto fair = ++runs % injected_interval == 0;
+        if ((fair && pop_injected(job)) || pop(index, job) ||
+            pop_injected(job) || steal(index, job))
+        {
+            --pending_;
+            job();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(idle_mutex_);
+        ++sleeping_;
+        idle_.wait(lock, [this]()
+        {
+            return pending_ > 0 || stopped_;
+        });
+        --sleeping_;
+
+        if (stopped_ && pending_ == 0)
+            return;
+    }
+}
+
+void scheduler::abort()
+{
+    aborted_ = true;
+    shutdown();
+}
+
+void scheduler::shutdown()
+{
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    stopped_ = true;
+    idle_.notify_all();
+}
+
+void scheduler::join()
+{
+    for (auto& thread: threads_)
+        if (thread.joinable())
+            thread.join();
+
+    // Abandoned tasks are released once the workers are gone.
+    for (auto& queue: queues_)
+    {
+        queue->high.clear();
+        queue->normal.clear();
+    }
+
+    injected_.high.clear();
+    injected_.normal.clear();
+
+    pending_ = 0;
+}
+
+} // namespace libbitcoin
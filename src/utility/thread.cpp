@@ -19,13 +19,17 @@
  */
 #include <bitcoin/bitcoin/utility/thread.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <stdexcept>
+#include <thread>
 
 #ifdef _MSC_VER
     #include <windows.h>
 #else
     #include <unistd.h>
     #include <pthread.h>
+    #include <sched.h>
     #include <sys/resource.h>
     #include <sys/types.h>
     #ifndef PRIO_MAX
@@ -71,4 +75,25 @@ void set_thread_priority(thread_priority priority)
 #endif
 }
 
+bool set_thread_affinity(size_t core)
+{
+    const size_t cores = std::max(std::thread::hardware_concurrency(), 1u);
+    const auto target = core % cores;
+
+#if defined(_MSC_VER)
+    if (target >= sizeof(DWORD_PTR) * 8)
+        return false;
+
+    const auto mask = static_cast<DWORD_PTR>(1) << target;
+    return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(target, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
 } // namespace libbitcoin
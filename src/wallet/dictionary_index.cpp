@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/wallet/dictionary_index.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <bitcoin/bitcoin/utility/collection.hpp>
+#include <bitcoin/bitcoin/wallet/dictionary.hpp>
+
+namespace libbitcoin {
+namespace wallet {
+
+dictionary_index::dictionary_index(const dictionary& lexicon)
+  : lexicon_(lexicon)
+{
+    for (size_t position = 0; position < sorted_.size(); ++position)
+        sorted_[position] = static_cast<uint16_t>(position);
+
+    // Words are ordered by bytes, which need not be the dictionary order.
+    const auto less = [&lexicon](uint16_t left, uint16_t right)
+    {
+        return std::strcmp(lexicon[left], lexicon[right]) < 0;
+    };
+
+    std::sort(sorted_.begin(), sorted_.end(), less);
+}
+
+const dictionary& dictionary_index::lexicon() const
+{
+    return lexicon_;
+}
+
+int dictionary_index::find(const char* word) const
+{
+    const auto& lexicon = lexicon_;
+    const auto less = [&lexicon](uint16_t position, const char* value)
+    {
+        return std::strcmp(lexicon[position], value) < 0;
+    };
+
+    const auto it = std::lower_bound(sorted_.begin(), sorted_.end(), word,
+        less);
+
+    if (it == sorted_.end() || std::strcmp(lexicon_[*it], word) != 0)
+        return -1;
+
+    return *it;
+}
+
+// A word containing a null character matches nothing.
+int dictionary_index::find(const std::string& word) const
+{
+    if (word.find('\0') != std::string::npos)
+        return -1;
+
+    return find(word.c_str());
+}
+
+// The dictionaries are constant initialized, so they precede these.
+static const dictionary_index en_index(language::en);
+static const dictionary_index es_index(language::es);
+static const dictionary_index ja_index(language::ja);
+static const dictionary_index zh_Hans_index(language::zh_Hans);
+static const dictionary_index zh_Hant_index(language::zh_Hant);
+
+static const dictionary_index* built_in_indexes[] =
+{
+    &en_index,
+    &es_index,
+    &ja_index,
+    &zh_Hans_index,
+    &zh_Hant_index
+};
+
+int find_word(const dictionary& lexicon, const std::string& word)
+{
+    for (const auto index: built_in_indexes)
+        if (&index->lexicon() == &lexicon)
+            return index->find(word);
+
+    return find_position(lexicon, word);
+}
+
+} // namespace wallet
+} // namespace libbitcoin
@@ -36,12 +36,8 @@ const uint8_t ec_public::uncompressed = 0x04;
 const uint8_t ec_public::mainnet_p2kh = 0x00;
 
 ec_public::ec_public()
- : valid_(false), compress_(true), point_(null_compressed_point)
-{
-}
-
-ec_public::ec_public(const ec_public& other)
-  : valid_(other.valid_), compress_(other.compress_), point_(other.point_)
+ : valid_(false), compress_(true), version_(mainnet_p2kh),
+   point_(null_compressed_point)
 {
 }
 
@@ -66,7 +62,7 @@ ec_public::ec_public(const ec_uncompressed& point, bool compress)
 }
 
 ec_public::ec_public(const ec_compressed& point, bool compress)
-  : valid_(true), compress_(compress), point_(point)
+  : valid_(true), compress_(compress), version_(mainnet_p2kh), point_(point)
 {
 }
 
@@ -89,13 +85,21 @@ ec_public ec_public::from_private(const ec_private& secret)
     return ec_public(secret.to_public());
 }
 
+// The point is decoded directly into an array of the implied size.
 ec_public ec_public::from_string(const std::string& base16)
 {
-    data_chunk decoded;
-    if (!decode_base16(decoded, base16))
+    if (base16.size() == 2 * ec_compressed_size)
+    {
+        ec_compressed compressed;
+        return decode_base16(compressed, base16) && is_point(compressed) ?
+            ec_public(compressed, true) : ec_public();
+    }
+
+    ec_uncompressed uncompressed;
+    if (!decode_base16(uncompressed, base16))
         return ec_public();
 
-    return ec_public(decoded);
+    return from_point(uncompressed, false);
 }
 
 ec_public ec_public::from_data(const data_chunk& decoded)
@@ -203,15 +207,6 @@ payment_address ec_public::to_payment_address(uint8_t version) const
 // Operators.
 // ----------------------------------------------------------------------------
 
-ec_public& ec_public::operator=(const ec_public& other)
-{
-    valid_ = other.valid_;
-    compress_ = other.compress_;
-    version_ = other.version_;
-    point_ = other.point_;
-    return *this;
-}
-
 bool ec_public::operator==(const ec_public& other) const
 {
     return valid_ == other.valid_ && compress_ == other.compress_ &&
@@ -22,19 +22,30 @@
 #include <cstdint>
 #include <cstddef>
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <map>
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <boost/locale.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/math/crypto.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/scrypt.hpp>
 #include <bitcoin/bitcoin/unicode/unicode.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
 #include <bitcoin/bitcoin/wallet/ec_private.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
+#include "../math/external/zeroize.h"
 #include "parse_encrypted_keys/parse_encrypted_key.hpp"
 #include "parse_encrypted_keys/parse_encrypted_prefix.hpp"
 #include "parse_encrypted_keys/parse_encrypted_private.hpp"
@@ -125,22 +136,25 @@ static one_byte point_sign(const one_byte& single, const hash_digest& hash)
 // scrypt_
 // ----------------------------------------------------------------------------
 
-static hash_digest scrypt_token(data_slice data, data_slice salt)
+static hash_digest scrypt_token(scrypt_context& context, data_slice data,
+    data_slice salt)
 {
     // Arbitrary scrypt parameters from BIP-38.
-    return scrypt<hash_size>(data, salt, 16384u, 8u, 8u);
+    return context.hash<hash_size>(data, salt, 16384u, 8u, 8u);
 }
 
-static long_hash scrypt_pair(data_slice data, data_slice salt)
+static long_hash scrypt_pair(scrypt_context& context, data_slice data,
+    data_slice salt)
 {
     // Arbitrary scrypt parameters from BIP-38.
-    return scrypt<long_hash_size>(data, salt, 1024u, 1u, 1u);
+    return context.hash<long_hash_size>(data, salt, 1024u, 1u, 1u);
 }
 
-static long_hash scrypt_private(data_slice data, data_slice salt)
+static long_hash scrypt_private(scrypt_context& context, data_slice data,
+    data_slice salt)
 {
     // Arbitrary scrypt parameters from BIP-38.
-    return scrypt<long_hash_size>(data, salt, 16384u, 8u, 8u);
+    return context.hash<long_hash_size>(data, salt, 16384u, 8u, 8u);
 }
 
 // set_flags
@@ -253,8 +267,9 @@ bool create_key_pair(encrypted_private& out_private,
     if (!address_salt(salt, point_copy, version, compressed))
         return false;
 
+    scrypt_context context;
     const auto salt_entropy = splice(salt, parse.entropy());
-    const auto derived = split(scrypt_pair(point, salt_entropy));
+    const auto derived = split(scrypt_pair(context, point, salt_entropy));
     const auto flags = set_flags(compressed, parse.lot_sequence(), true);
 
     if (!create_public_key(out_public, flags, salt, parse.entropy(),
@@ -296,8 +311,9 @@ static bool create_token(encrypted_token& out_token,
     BITCOIN_ASSERT(owner_salt.size() == ek_salt_size ||
         owner_salt.size() == ek_entropy_size);
 
+    scrypt_context context;
     const auto lot_sequence = owner_salt.size() == ek_salt_size;
-    auto factor = scrypt_token(normal(passphrase), owner_salt);
+    auto factor = scrypt_token(context, normal(passphrase), owner_salt);
 
     if (lot_sequence)
         factor = bitcoin_hash(splice(factor, owner_entropy));
@@ -350,7 +366,9 @@ bool encrypt(encrypted_private& out_private, const ec_secret& secret,
     if (!address_salt(salt, secret, version, compressed))
         return false;
 
-    const auto derived = split(scrypt_private(normal(passphrase), salt));
+    scrypt_context context;
+    const auto derived = split(scrypt_private(context, normal(passphrase),
+        salt));
     const auto prefix = parse_encrypted_private::prefix_factory(version,
         false);
 
@@ -373,10 +391,19 @@ bool encrypt(encrypted_private& out_private, const ec_secret& secret,
 // decrypt private_key
 // ----------------------------------------------------------------------------
 
+// The pass factor depends only upon the passphrase and the owner salt, so it
+// is shared by all keys generated from the same intermediate passphrase.
+static hash_digest pass_factor(scrypt_context& context,
+    const parse_encrypted_private& parse, data_slice passphrase)
+{
+    return scrypt_token(context, passphrase, parse.owner_salt());
+}
+
 static bool decrypt_multiplied(ec_secret& out_secret,
-    const parse_encrypted_private& parse, const std::string& passphrase)
+    const parse_encrypted_private& parse, const hash_digest& pass_factor,
+    scrypt_context& context)
 {
-    auto secret = scrypt_token(normal(passphrase), parse.owner_salt());
+    auto secret = pass_factor;
 
     if (parse.lot_sequence())
         secret = bitcoin_hash(splice(secret, parse.entropy()));
@@ -386,7 +413,7 @@ static bool decrypt_multiplied(ec_secret& out_secret,
         return false;
 
     const auto salt_entropy = splice(parse.salt(), parse.entropy());
-    const auto derived = split(scrypt_pair(point, salt_entropy));
+    const auto derived = split(scrypt_pair(context, point, salt_entropy));
 
     auto encrypt1 = parse.data1();
     auto encrypt2 = parse.data2();
@@ -412,11 +439,12 @@ static bool decrypt_multiplied(ec_secret& out_secret,
 }
 
 static bool decrypt_secret(ec_secret& out_secret,
-    const parse_encrypted_private& parse, const std::string& passphrase)
+    const parse_encrypted_private& parse, data_slice passphrase,
+    scrypt_context& context)
 {
     auto encrypt1 = splice(parse.entropy(), parse.data1());
     auto encrypt2 = parse.data2();
-    const auto derived = split(scrypt_private(normal(passphrase),
+    const auto derived = split(scrypt_private(context, passphrase,
         parse.salt()));
 
     aes256_decrypt(derived.right, encrypt1);
@@ -441,9 +469,12 @@ bool decrypt(ec_secret& out_secret, uint8_t& out_version, bool& out_compressed,
     if (!parse.valid())
         return false;
 
+    scrypt_context context;
+    const auto normal_passphrase = normal(passphrase);
     const auto success = parse.multiplied() ?
-        decrypt_multiplied(out_secret, parse, passphrase) :
-        decrypt_secret(out_secret, parse, passphrase);
+        decrypt_multiplied(out_secret, parse,
+            pass_factor(context, parse, normal_passphrase), context) :
+        decrypt_secret(out_secret, parse, normal_passphrase, context);
 
     if (success)
     {
@@ -454,6 +485,141 @@ bool decrypt(ec_secret& out_secret, uint8_t& out_version, bool& out_compressed,
     return success;
 }
 
+// decrypt private_key batch
+// ----------------------------------------------------------------------------
+
+// Pass factors computed by any worker, keyed by owner salt.
+class pass_factor_cache
+{
+public:
+    bool find(hash_digest& out_factor, const data_chunk& owner_salt)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = factors_.find(owner_salt);
+        if (it == factors_.end())
+            return false;
+
+        out_factor = it->second;
+        return true;
+    }
+
+    // The factors are derived from the passphrase, so clear them.
+    ~pass_factor_cache()
+    {
+        for (auto& factor: factors_)
+            zeroize(factor.second.data(), factor.second.size());
+    }
+
+    void store(const data_chunk& owner_salt, const hash_digest& factor)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        factors_.emplace(owner_salt, factor);
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<data_chunk, hash_digest> factors_;
+};
+
+static bool decrypt_key(ek_decrypted& out_decrypted,
+    const encrypted_private& key, data_slice passphrase,
+    scrypt_context& context, pass_factor_cache& cache)
+{
+    const parse_encrypted_private parse(key);
+    if (!parse.valid())
+        return false;
+
+    auto& secret = out_decrypted.secret;
+    if (parse.multiplied())
+    {
+        hash_digest factor;
+        const auto owner_salt = parse.owner_salt();
+        if (!cache.find(factor, owner_salt))
+        {
+            factor = pass_factor(context, parse, passphrase);
+            cache.store(owner_salt, factor);
+        }
+
+        if (!decrypt_multiplied(secret, parse, factor, context))
+            return false;
+    }
+    else if (!decrypt_secret(secret, parse, passphrase, context))
+        return false;
+
+    out_decrypted.compressed = parse.compressed();
+    out_decrypted.version = parse.address_version();
+    return true;
+}
+
+bool decrypt(ek_decrypted_list& out_secrets,
+    const encrypted_private_list& keys, const std::string& passphrase,
+    size_t threads)
+{
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    const auto workers = std::min(threads, keys.size());
+    const auto normal_passphrase = normal(passphrase);
+    std::atomic<size_t> next(0);
+    pass_factor_cache cache;
+    ek_decrypted_list decrypted(keys.size());
+
+    std::mutex failure_mutex;
+    std::exception_ptr failure;
+
+    // Keys are claimed in order, each worker mixing its lanes serially so
+    // that scrypt memory is bounded by the worker count. The first failure
+    // (such as scrypt allocation) ends the claims and is raised by the caller.
+    const auto work = [&]()
+    {
+        try
+        {
+            scrypt_context context(1);
+            for (auto index = next++; index < keys.size(); index = next++)
+            {
+                auto& result = decrypted[index];
+                result.valid = decrypt_key(result, keys[index],
+                    normal_passphrase, context, cache);
+            }
+        }
+        catch (...)
+        {
+            next = keys.size();
+            std::lock_guard<std::mutex> lock(failure_mutex);
+            if (!failure)
+                failure = std::current_exception();
+        }
+    };
+
+    // The calling thread is the first worker, and claims the keys of any
+    // worker that cannot be started.
+    std::vector<std::thread> pool;
+    pool.reserve(workers == 0 ? 0 : workers - 1);
+    try
+    {
+        for (size_t worker = 1; worker < workers; ++worker)
+            pool.emplace_back(work);
+    }
+    catch (const std::system_error&)
+    {
+    }
+
+    work();
+    for (auto& thread: pool)
+        thread.join();
+
+    if (failure)
+        std::rethrow_exception(failure);
+
+    const auto valid = [](const ek_decrypted& result)
+    {
+        return result.valid;
+    };
+
+    out_secrets = std::move(decrypted);
+    return std::all_of(out_secrets.begin(), out_secrets.end(), valid);
+}
+
 // decrypt public_key
 // ----------------------------------------------------------------------------
 
@@ -467,7 +633,9 @@ bool decrypt(ec_compressed& out_point, uint8_t& out_version,
 
     const auto version = parse.address_version();
     const auto lot_sequence = parse.lot_sequence();
-    auto factor = scrypt_token(normal(passphrase), parse.owner_salt());
+    scrypt_context context;
+    auto factor = scrypt_token(context, normal(passphrase),
+        parse.owner_salt());
 
     if (lot_sequence)
         factor = bitcoin_hash(splice(factor, parse.entropy()));
@@ -477,7 +645,7 @@ bool decrypt(ec_compressed& out_point, uint8_t& out_version,
         return false;
 
     const auto salt_entropy = splice(parse.salt(), parse.entropy());
-    auto derived = split(scrypt_pair(point, salt_entropy));
+    auto derived = split(scrypt_pair(context, point, salt_entropy));
     auto encrypt = split(parse.data());
 
     aes256_decrypt(derived.right, encrypt.left);
@@ -18,6 +18,7 @@
  */
 #include <bitcoin/bitcoin/wallet/hd_private.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <boost/program_options.hpp>
@@ -27,6 +28,7 @@
 #include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/hash_context.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/deserializer.hpp>
@@ -224,10 +226,21 @@ hd_key hd_private::to_hd_key() const
     return out;
 }
 
+// The public key is already computed, so this does not round trip the key.
 hd_public hd_private::to_public() const
 {
-    return hd_public(((hd_public)*this).to_hd_key(), 
-        hd_public::to_prefix(lineage_.prefixes));
+    if (!valid_)
+        return hd_public();
+
+    const hd_lineage lineage
+    {
+        hd_public::to_prefix(lineage_.prefixes),
+        lineage_.depth,
+        lineage_.parent_fingerprint,
+        lineage_.child_number
+    };
+
+    return from_point(point_, chain_, lineage);
 }
 
 hd_private hd_private::derive_private(uint32_t index) const
@@ -264,6 +277,62 @@ hd_public hd_private::derive_public(uint32_t index) const
     return derive_private(index).to_public();
 }
 
+hd_private_list hd_private::derive_range(uint32_t first, uint32_t count,
+    size_t threads) const
+{
+    static constexpr uint8_t private_key_padding = 0x00;
+    hd_private_list children(range_size(first, count));
+
+    if (!valid_ || lineage_.depth == max_uint8)
+        return children;
+
+    // The key schedule and the parent fingerprint are shared by all children.
+    const hmac_sha512_context keyed(chain_);
+    const auto parent = fingerprint();
+    const auto depth = static_cast<uint8_t>(lineage_.depth + 1);
+
+    const auto derive = [&](size_t begin, size_t end)
+    {
+        auto context = keyed;
+
+        for (auto position = begin; position < end; ++position)
+        {
+            const auto index = static_cast<uint32_t>(first + position);
+
+            if (index >= hd_first_hardened_key)
+            {
+                context.write_byte(private_key_padding);
+                context.write_data(secret_.data(), secret_.size());
+            }
+            else
+            {
+                context.write_data(point_.data(), point_.size());
+            }
+
+            context.write_4_bytes_big_endian(index);
+            const auto intermediate = split(context.finalize());
+
+            auto child = secret_;
+            if (!ec_add(child, intermediate.left))
+                continue;
+
+            const hd_lineage lineage
+            {
+                lineage_.prefixes,
+                depth,
+                parent,
+                index
+            };
+
+            children[position] = hd_private(child, intermediate.right,
+                lineage);
+        }
+    };
+
+    divide_range(children.size(), threads, derive);
+    return children;
+}
+
 // Operators.
 // ----------------------------------------------------------------------------
 
@@ -18,8 +18,12 @@
  */
 #include <bitcoin/bitcoin/wallet/hd_public.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <thread>
+#include <vector>
 #include <boost/program_options.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/define.hpp>
@@ -27,6 +31,7 @@
 #include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/hash_context.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
@@ -95,6 +100,12 @@ hd_public hd_public::from_secret(const ec_secret& secret,
         hd_public(point, chain_code, lineage) : hd_public();
 }
 
+hd_public hd_public::from_point(const ec_compressed& point,
+    const hd_chain_code& chain_code, const hd_lineage& lineage)
+{
+    return hd_public(point, chain_code, lineage);
+}
+
 hd_public hd_public::from_key(const hd_key& key)
 {
     const auto prefix = from_big_endian_unsafe<uint32_t>(key.begin());
@@ -236,6 +247,54 @@ hd_public hd_public::derive_public(uint32_t index) const
     return hd_public(combined, intermediate.right, lineage);
 }
 
+hd_public_list hd_public::derive_range(uint32_t first, uint32_t count,
+    size_t threads) const
+{
+    hd_public_list children(range_size(first, count));
+
+    if (!valid_ || lineage_.depth == max_uint8)
+        return children;
+
+    // The key schedule and the parent fingerprint are shared by all children.
+    const hmac_sha512_context keyed(chain_);
+    const auto parent = fingerprint();
+    const auto depth = static_cast<uint8_t>(lineage_.depth + 1);
+
+    const auto derive = [&](size_t begin, size_t end)
+    {
+        auto context = keyed;
+
+        for (auto position = begin; position < end; ++position)
+        {
+            const auto index = static_cast<uint32_t>(first + position);
+            if (index >= hd_first_hardened_key)
+                break;
+
+            context.write_data(point_.data(), point_.size());
+            context.write_4_bytes_big_endian(index);
+            const auto intermediate = split(context.finalize());
+
+            auto combined = point_;
+            if (!ec_add(combined, intermediate.left))
+                continue;
+
+            const hd_lineage lineage
+            {
+                lineage_.prefixes,
+                depth,
+                parent,
+                index
+            };
+
+            children[position] = hd_public(combined, intermediate.right,
+                lineage);
+        }
+    };
+
+    divide_range(children.size(), threads, derive);
+    return children;
+}
+
 // Helpers.
 // ----------------------------------------------------------------------------
 
@@ -245,6 +304,34 @@ uint32_t hd_public::fingerprint() const
     return from_big_endian_unsafe<uint32_t>(message_digest.begin());
 }
 
+// Indexes are limited to 32 bits, so the range ends at the last index.
+size_t hd_public::range_size(uint32_t first, uint32_t count)
+{
+    const uint64_t available = uint64_t(max_uint32) - first + 1;
+    return static_cast<size_t>(std::min(available, uint64_t(count)));
+}
+
+// Divide [0, count) into contiguous partitions, one per thread.
+// The calling thread processes the first partition.
+void hd_public::divide_range(size_t count, size_t threads,
+    range_handler handler)
+{
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    threads = std::max(std::min(threads, count), size_t(1));
+    const auto size = (count + threads - 1) / threads;
+
+    std::vector<std::thread> workers;
+    for (auto begin = size; begin < count; begin += size)
+        workers.emplace_back(handler, begin, std::min(begin + size, count));
+
+    handler(0, std::min(size, count));
+
+    for (auto& worker: workers)
+        worker.join();
+}
+
 // Operators.
 // ----------------------------------------------------------------------------
 
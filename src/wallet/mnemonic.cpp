@@ -20,7 +20,10 @@
 #include <bitcoin/bitcoin/wallet/mnemonic.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <thread>
+#include <vector>
 #include <boost/locale.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/unicode/unicode.hpp>
@@ -29,6 +32,7 @@
 #include <bitcoin/bitcoin/utility/collection.hpp>
 #include <bitcoin/bitcoin/utility/string.hpp>
 #include <bitcoin/bitcoin/wallet/dictionary.hpp>
+#include <bitcoin/bitcoin/wallet/dictionary_index.hpp>
 #include "../math/external/pkcs5_pbkdf2.h"
 
 namespace libbitcoin {
@@ -62,7 +66,7 @@ bool validate_mnemonic(const word_list& words, const dictionary& lexicon)
 
     for (const auto& word: words)
     {
-        const auto position = find_position(lexicon, word);
+        const auto position = find_word(lexicon, word);
         if (position == -1)
             return false;
 
@@ -76,10 +80,25 @@ bool validate_mnemonic(const word_list& words, const dictionary& lexicon)
         }
     }
 
-    data.resize(entropy_bits / byte_bits);
+    // The checksum is the leading bits of the entropy hash.
+    const auto entropy = data.data();
+    const auto checksum = sha256_hash(data_slice(entropy,
+        entropy + entropy_bits / byte_bits));
 
-    const auto mnemonic = create_mnemonic(data, lexicon);
-    return std::equal(mnemonic.begin(), mnemonic.end(), words.begin());
+    if (check_bits > checksum.size() * byte_bits)
+        return false;
+
+    // The checksum is byte aligned, so bits share masks with their hash bits.
+    for (auto checked = entropy_bits; checked < total_bits; ++checked)
+    {
+        const auto check = checked - entropy_bits;
+        const auto mask = bip39_shift(checked);
+        if ((data[checked / byte_bits] & mask) !=
+            (checksum[check / byte_bits] & mask))
+            return false;
+    }
+
+    return true;
 }
 
 word_list create_mnemonic(data_slice entropy, const dictionary &lexicon)
@@ -132,12 +151,55 @@ bool validate_mnemonic(const word_list& mnemonic,
     return false;
 }
 
-long_hash decode_mnemonic(const word_list& mnemonic)
+static long_hash decode_seed(const word_list& mnemonic, data_slice salt)
 {
     const auto sentence = join(mnemonic);
+    return pkcs5_pbkdf2_hmac_sha512(to_chunk(sentence), salt,
+        hmac_iterations);
+}
+
+static long_hash_list decode_seeds(const mnemonic_list& mnemonics,
+    data_slice salt, size_t threads)
+{
+    const auto count = mnemonics.size();
+    long_hash_list seeds(count);
+
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    threads = std::min(threads, count);
+    std::atomic<size_t> next(0);
+
+    // Each seed costs thousands of hmac rounds, so workers claim one at a time.
+    const auto work = [&]()
+    {
+        for (auto index = next++; index < count; index = next++)
+            seeds[index] = decode_seed(mnemonics[index], salt);
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t worker = 1; worker < threads; ++worker)
+        workers.emplace_back(work);
+
+    work();
+
+    for (auto& worker: workers)
+        worker.join();
+
+    return seeds;
+}
+
+long_hash decode_mnemonic(const word_list& mnemonic)
+{
+    const std::string salt(passphrase_prefix);
+    return decode_seed(mnemonic, to_chunk(salt));
+}
+
+long_hash_list decode_mnemonics(const mnemonic_list& mnemonics,
+    size_t threads)
+{
     const std::string salt(passphrase_prefix);
-    return pkcs5_pbkdf2_hmac_sha512(to_chunk(sentence),
-        to_chunk(salt), hmac_iterations);
+    return decode_seeds(mnemonics, to_chunk(salt), threads);
 }
 
 #ifdef WITH_ICU
@@ -145,11 +207,18 @@ long_hash decode_mnemonic(const word_list& mnemonic)
 long_hash decode_mnemonic(const word_list& mnemonic,
     const std::string& passphrase)
 {
-    const auto sentence = join(mnemonic);
     const std::string prefix(passphrase_prefix);
     const auto salt = to_normal_nfkd_form(prefix + passphrase);
-    return pkcs5_pbkdf2_hmac_sha512(to_chunk(sentence),
-        to_chunk(salt), hmac_iterations);
+    return decode_seed(mnemonic, to_chunk(salt));
+}
+
+long_hash_list decode_mnemonics(const mnemonic_list& mnemonics,
+    const std::string& passphrase, size_t threads)
+{
+    // The passphrase is normalized once for the batch.
+    const std::string prefix(passphrase_prefix);
+    const auto salt = to_normal_nfkd_form(prefix + passphrase);
+    return decode_seeds(mnemonics, to_chunk(salt), threads);
 }
 
 #endif
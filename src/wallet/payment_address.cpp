@@ -40,11 +40,6 @@ payment_address::payment_address()
 {
 }
 
-payment_address::payment_address(const payment_address& other)
-  : valid_(other.valid_), version_(other.version_), hash_(other.hash_)
-{
-}
-
 payment_address::payment_address(const payment& decoded)
   : payment_address(from_payment(decoded))
 {
@@ -124,9 +119,12 @@ payment_address payment_address::from_public(const ec_public& point,
     if (!point)
         return payment_address();
 
-    data_chunk data;
-    return point.to_data(data) ?
-        payment_address(bitcoin_short_hash(data), version) :
+    if (point.compressed())
+        return payment_address(bitcoin_short_hash(point.point()), version);
+
+    ec_uncompressed uncompressed;
+    return point.to_uncompressed(uncompressed) ?
+        payment_address(bitcoin_short_hash(uncompressed), version) :
         payment_address();
 }
 
@@ -181,14 +179,6 @@ payment payment_address::to_payment() const
 // Operators.
 // ----------------------------------------------------------------------------
 
-payment_address& payment_address::operator=(const payment_address& other)
-{
-    valid_ = other.valid_;
-    version_ = other.version_;
-    hash_ = other.hash_;
-    return *this;
-}
-
 bool payment_address::operator==(const payment_address& other) const
 {
     return valid_ == other.valid_ && version_ == other.version_ &&
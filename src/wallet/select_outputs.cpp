@@ -20,70 +20,362 @@
 #include <bitcoin/bitcoin/wallet/select_outputs.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <cstddef>
+#include <vector>
 #include <bitcoin/bitcoin/constants.hpp>
-#include <bitcoin/bitcoin/formats/base16.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
-#include <bitcoin/bitcoin/utility/data.hpp>
-#include <bitcoin/bitcoin/utility/endian.hpp>
-#include <bitcoin/bitcoin/utility/serializer.hpp>
+#include <bitcoin/bitcoin/utility/random.hpp>
 
 namespace libbitcoin {
 namespace wallet {
 
-select_outputs_result select_outputs(output_info_list unspent,
-    uint64_t min_value, select_outputs_algorithm DEBUG_ONLY(algorithm))
+using namespace bc::chain;
+
+// The deadline is tested once per this many search iterations.
+static const size_t deadline_interval = 1024;
+
+// The number of stochastic approximation rounds of the knapsack selection.
+static const size_t knapsack_rounds = 1000;
+
+const output_index::duration output_index::default_timeout(100);
+
+static bool point_less(const output_point& left, const output_point& right)
+{
+    return left.hash == right.hash ? left.index < right.index :
+        left.hash < right.hash;
+}
+
+bool output_index::point_order::operator()(const output_point& left,
+    const output_point& right) const
+{
+    return point_less(left, right);
+}
+
+// Outputs of equal value are distinguished by point, allowing removal.
+bool output_index::value_order::operator()(const output_info& left,
+    const output_info& right) const
 {
-    // Just one default implementation for now.
-    // Consider a switch case with greedy_select_outputs(min_value) etc.
-    // if this is ever extended with more algorithms.
-    BITCOIN_ASSERT(algorithm == select_outputs_algorithm::greedy);
+    return left.value == right.value ? point_order()(left.point, right.point) :
+        left.value < right.value;
+}
+
+output_index::output_index()
+  : value_(0)
+{
+}
+
+bool output_index::insert(const output_info& output)
+{
+    const auto inserted = points_.emplace(output.point, output.value);
+
+    if (!inserted.second)
+        return false;
 
-    if (unspent.empty())
+    values_.insert(output);
+    value_ += output.value;
+    return true;
+}
+
+bool output_index::remove(const output_point& point)
+{
+    const auto it = points_.find(point);
+
+    if (it == points_.end())
+        return false;
+
+    values_.erase(output_info{ point, it->second });
+    value_ -= it->second;
+    points_.erase(it);
+    return true;
+}
+
+void output_index::remove(const output_point::list& points)
+{
+    for (const auto& point: points)
+        remove(point);
+}
+
+size_t output_index::size() const
+{
+    return values_.size();
+}
+
+uint64_t output_index::value() const
+{
+    return value_;
+}
+
+// The first output with a value of at least the given value.
+output_index::value_set::const_iterator output_index::lower_bound(
+    uint64_t value) const
+{
+    static const output_point least{ null_hash, 0 };
+    return values_.lower_bound(output_info{ least, value });
+}
+
+select_outputs_result output_index::select(uint64_t min_value,
+    select_outputs_algorithm algorithm, uint64_t tolerance,
+    const duration& timeout) const
+{
+    if (values_.empty() || value_ < min_value)
         return select_outputs_result();
 
-    const auto less_than_min_value = [min_value](const output_info& out_info)
+    const auto deadline = clock::now() + timeout;
+
+    switch (algorithm)
     {
-        return out_info.value < min_value;
-    };
+        case select_outputs_algorithm::largest_first:
+            return select_largest_first(min_value);
+        case select_outputs_algorithm::branch_and_bound:
+            return select_branch_and_bound(min_value, tolerance, deadline);
+        case select_outputs_algorithm::knapsack:
+            return select_knapsack(min_value, deadline);
+        case select_outputs_algorithm::greedy:
+        default:
+            return select_greedy(min_value);
+    }
+}
+
+// The smallest single sufficient output, or else the largest outputs.
+select_outputs_result output_index::select_greedy(uint64_t min_value) const
+{
+    const auto min_greater = lower_bound(min_value);
+
+    if (min_greater == values_.end())
+        return select_largest_first(min_value);
+
+    select_outputs_result result;
+    result.change = min_greater->value - min_value;
+    result.points.push_back(min_greater->point);
+    return result;
+}
+
+// The fewest outputs, taken from the largest down.
+select_outputs_result output_index::select_largest_first(
+    uint64_t min_value) const
+{
+    select_outputs_result result;
+    uint64_t accumulator = 0;
 
-    const auto lesser = [](const output_info& left, const output_info& right)
+    for (auto it = values_.rbegin(); it != values_.rend(); ++it)
     {
-        return left.value < right.value;
-    };
+        result.points.push_back(it->point);
+        accumulator += it->value;
 
-    const auto greater = [](const output_info& left, const output_info& right)
+        if (accumulator >= min_value)
+        {
+            result.change = accumulator - min_value;
+            return result;
+        }
+    }
+
+    return select_outputs_result();
+}
+
+// Depth first search for the subset with least change within the tolerance.
+// Candidates are visited from the largest, so the remaining sum bounds each
+// branch, and an omitted value is not retried by an equal successor.
+select_outputs_result output_index::select_branch_and_bound(
+    uint64_t min_value, uint64_t tolerance,
+    const clock::time_point& deadline) const
+{
+    const auto max_value = min_value > max_uint64 - tolerance ? max_uint64 :
+        min_value + tolerance;
+
+    // Outputs above the maximum cannot be part of any solution.
+    candidate_list candidates;
+    for (auto it = values_.rbegin(); it != values_.rend(); ++it)
+        if (it->value <= max_value)
+            candidates.push_back(&(*it));
+
+    const auto count = candidates.size();
+    std::vector<uint64_t> remaining(count + 1, 0);
+    for (auto index = count; index > 0; --index)
+        remaining[index - 1] = remaining[index] + candidates[index - 1]->value;
+
+    std::vector<size_t> selected;
+    std::vector<size_t> best;
+    auto best_change = max_uint64;
+    uint64_t total = 0;
+    size_t index = 0;
+
+    for (size_t iteration = 1; ; ++iteration)
     {
-        return left.value > right.value;
-    };
+        if (iteration % deadline_interval == 0 && clock::now() > deadline)
+            break;
+
+        auto backtrack = true;
 
-    const auto lesser_begin = unspent.begin();
-    const auto lesser_end = std::partition(unspent.begin(), unspent.end(),
-        less_than_min_value);
+        if (total + remaining[index] < min_value || total > max_value)
+        {
+            // This branch cannot reach a solution.
+        }
+        else if (total >= min_value)
+        {
+            const auto change = total - min_value;
 
-    const auto greater_begin = lesser_end;
-    const auto greater_end = unspent.end();
-    const auto min_greater = std::min_element(greater_begin, greater_end,
-        lesser);
+            if (change < best_change || (change == best_change &&
+                selected.size() < best.size()))
+            {
+                best = selected;
+                best_change = change;
+            }
+
+            if (best_change == 0)
+                break;
+        }
+        else if (index < count)
+        {
+            backtrack = false;
+        }
+
+        if (backtrack)
+        {
+            if (selected.empty())
+                break;
+
+            // Replace the last inclusion with its omission.
+            const auto omitted = selected.back();
+            selected.pop_back();
+            total -= candidates[omitted]->value;
+            index = omitted + 1;
+
+            while (index < count &&
+                candidates[index]->value == candidates[omitted]->value)
+                ++index;
+        }
+        else
+        {
+            selected.push_back(index);
+            total += candidates[index]->value;
+            ++index;
+        }
+    }
+
+    if (best.empty())
+        return select_outputs_result();
 
     select_outputs_result result;
-    if (min_greater != greater_end)
+    result.change = best_change;
+    result.points.reserve(best.size());
+
+    for (const auto index: best)
+        result.points.push_back(candidates[index]->point);
+
+    return result;
+}
+
+// Stochastic approximation of the subset of lesser outputs with least excess,
+// compared to the smallest single sufficient output, as in the satoshi client.
+select_outputs_result output_index::select_knapsack(uint64_t min_value,
+    const clock::time_point& deadline) const
+{
+    const auto min_greater = lower_bound(min_value);
+
+    candidate_list lessers;
+    uint64_t lesser_total = 0;
+    for (auto it = values_.begin(); it != min_greater; ++it)
+    {
+        lessers.push_back(&(*it));
+        lesser_total += it->value;
+    }
+
+    std::reverse(lessers.begin(), lessers.end());
+
+    const auto count = lessers.size();
+    std::vector<bool> best(count, true);
+    auto best_total = lesser_total;
+
+    if (lesser_total > min_value)
+    {
+        xoshiro256 generator(pseudo_random());
+        std::vector<bool> included(count);
+
+        for (size_t round = 0; round < knapsack_rounds &&
+            best_total != min_value && clock::now() <= deadline; ++round)
+        {
+            std::fill(included.begin(), included.end(), false);
+            uint64_t total = 0;
+            auto reached = false;
+
+            // Randomly include, then include the remainder until reached.
+            for (size_t pass = 0; pass < 2 && !reached; ++pass)
+            {
+                for (size_t index = 0; index < count; ++index)
+                {
+                    const auto include = pass == 0 ? (generator() & 1) != 0 :
+                        !included[index];
+
+                    if (!include)
+                        continue;
+
+                    total += lessers[index]->value;
+                    included[index] = true;
+
+                    if (total < min_value)
+                        continue;
+
+                    reached = true;
+
+                    if (total < best_total)
+                    {
+                        best_total = total;
+                        best = included;
+                    }
+
+                    // Try for a closer total without this output.
+                    total -= lessers[index]->value;
+                    included[index] = false;
+                }
+            }
+        }
+    }
+
+    select_outputs_result result;
+    const auto sufficient = lesser_total >= min_value;
+
+    if (min_greater != values_.end() &&
+        (!sufficient || min_greater->value <= best_total))
     {
         result.change = min_greater->value - min_value;
         result.points.push_back(min_greater->point);
         return result;
     }
-    // Not found in greaters so try several lessers instead. Rearrange from
-    // biggest to smallest. We want to use the fewest inputs possible.
-    std::sort(lesser_begin, lesser_end, greater);
 
+    if (!sufficient)
+        return select_outputs_result();
+
+    result.change = best_total - min_value;
+
+    for (size_t index = 0; index < count; ++index)
+        if (best[index])
+            result.points.push_back(lessers[index]->point);
+
+    return result;
+}
+
+// The largest of the outputs, until sufficient.
+static select_outputs_result select_largest_first(
+    std::vector<const output_info*>& outputs, uint64_t min_value)
+{
+    const auto greater = [](const output_info* left, const output_info* right)
+    {
+        return left->value > right->value;
+    };
+
+    std::sort(outputs.begin(), outputs.end(), greater);
+
+    select_outputs_result result;
     uint64_t accumulator = 0;
-    for (auto it = lesser_begin; it != lesser_end; ++it)
+
+    for (const auto output: outputs)
     {
-        result.points.push_back(it->point);
-        accumulator += it->value;
+        result.points.push_back(output->point);
+        accumulator += output->value;
+
         if (accumulator >= min_value)
         {
             result.change = accumulator - min_value;
@@ -94,5 +386,69 @@ select_outputs_result select_outputs(output_info_list unspent,
     return select_outputs_result();
 }
 
+// Duplicate points are counted once, as by the index. Sorting by point also
+// orders outputs of equal value as the index does.
+static void distinct(std::vector<const output_info*>& outputs)
+{
+    const auto less = [](const output_info* left, const output_info* right)
+    {
+        return point_less(left->point, right->point);
+    };
+
+    const auto equal = [](const output_info* left, const output_info* right)
+    {
+        return left->point == right->point;
+    };
+
+    std::stable_sort(outputs.begin(), outputs.end(), less);
+    outputs.erase(std::unique(outputs.begin(), outputs.end(), equal),
+        outputs.end());
+}
+
+// A one-shot selection does not need an index for the greedy algorithms,
+// the smallest sufficient output is found in a single pass.
+select_outputs_result select_outputs(const output_info_list& unspent,
+    uint64_t min_value, select_outputs_algorithm algorithm,
+    uint64_t tolerance)
+{
+    if (algorithm == select_outputs_algorithm::branch_and_bound ||
+        algorithm == select_outputs_algorithm::knapsack)
+    {
+        output_index index;
+
+        for (const auto& output: unspent)
+            index.insert(output);
+
+        return index.select(min_value, algorithm, tolerance);
+    }
+
+    std::vector<const output_info*> outputs;
+    outputs.reserve(unspent.size());
+
+    for (const auto& output: unspent)
+        outputs.push_back(&output);
+
+    distinct(outputs);
+
+    if (algorithm == select_outputs_algorithm::largest_first)
+        return select_largest_first(outputs, min_value);
+
+    const output_info* min_greater = nullptr;
+
+    for (const auto output: outputs)
+        if (output->value >= min_value && (min_greater == nullptr ||
+            output->value < min_greater->value))
+            min_greater = output;
+
+    // Without a sufficient output all of the outputs are lesser.
+    if (min_greater == nullptr)
+        return select_largest_first(outputs, min_value);
+
+    select_outputs_result result;
+    result.change = min_greater->value - min_value;
+    result.points.push_back(min_greater->point);
+    return result;
+}
+
 } // namspace wallet
 } // namspace libbitcoin
@@ -0,0 +1,297 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/wallet/stealth_scanner.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/script.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/stealth.hpp>
+#include <bitcoin/bitcoin/utility/binary.hpp>
+#include <bitcoin/bitcoin/utility/scheduler.hpp>
+#include <bitcoin/bitcoin/wallet/payment_address.hpp>
+#include <bitcoin/bitcoin/wallet/stealth_address.hpp>
+
+namespace libbitcoin {
+namespace wallet {
+
+using namespace bc::chain;
+
+// A stealth output paired with the payment output that follows it.
+struct stealth_candidate
+{
+    size_t transaction;
+    uint32_t index;
+    uint32_t prefix;
+    ec_compressed ephemeral_key;
+    short_hash payment;
+};
+
+// A candidate that passes the filter of a key, pending the ecdh test.
+struct stealth_pairing
+{
+    size_t candidate;
+    size_t key;
+    bool matched;
+    ec_compressed stealth_key;
+};
+
+// The number of key buckets, one for each value of a filter's first byte.
+static const size_t bucket_count = 256;
+
+bool stealth_scanner::to_scan_key(stealth_scan_key& out_key,
+    const stealth_address& address, const ec_secret& scan_secret)
+{
+    const auto& spend_keys = address.spend_keys();
+
+    if (spend_keys.size() > 1)
+        return false;
+
+    // The scan key is its own spend key if none is specified.
+    auto spend_key = address.scan_key();
+    if (!spend_keys.empty())
+        spend_key = spend_keys.front();
+
+    out_key = stealth_scan_key{ scan_secret, spend_key, address.filter() };
+    return true;
+}
+
+stealth_scanner::stealth_scanner(const stealth_scan_key::list& keys,
+    uint8_t p2kh_version)
+  : keys_(keys), p2kh_version_(p2kh_version), buckets_(bucket_count)
+{
+    for (size_t key = 0; key < keys_.size(); ++key)
+    {
+        const auto& filter = keys_[key].filter;
+
+        if (filter.size() < binary_type::bits_per_block)
+            unbucketed_.push_back(key);
+        else
+            buckets_[filter.blocks().front()].push_back(key);
+    }
+}
+
+const stealth_scan_key::list& stealth_scanner::keys() const
+{
+    return keys_;
+}
+
+// The keys whose filter the prefix satisfies, in key order.
+void stealth_scanner::pair(key_indexes& out_keys, uint32_t prefix) const
+{
+    out_keys.clear();
+
+    // The leading byte of the prefix is its least significant byte.
+    const auto& bucket = buckets_[prefix & 0xff];
+    auto bucketed = bucket.begin();
+    auto unbucketed = unbucketed_.begin();
+
+    while (bucketed != bucket.end() || unbucketed != unbucketed_.end())
+    {
+        size_t key;
+        if (unbucketed == unbucketed_.end() ||
+            (bucketed != bucket.end() && *bucketed < *unbucketed))
+            key = *bucketed++;
+        else
+            key = *unbucketed++;
+
+        if (keys_[key].filter.is_prefix_of(prefix))
+            out_keys.push_back(key);
+    }
+}
+
+// The state of a scan, shared with any scheduled tasks that outlive it.
+struct stealth_scanner::scan_state
+{
+    std::vector<stealth_candidate> candidates;
+    std::vector<stealth_pairing> pairings;
+    std::atomic<size_t> next;
+    size_t completed;
+    std::mutex mutex;
+    std::condition_variable done;
+};
+
+// Collect the stealth outputs and pair them with keys, without any elliptic
+// curve work.
+std::shared_ptr<stealth_scanner::scan_state> stealth_scanner::prepare(
+    const block& block) const
+{
+    auto state = std::make_shared<scan_state>();
+    state->next = 0;
+    state->completed = 0;
+
+    auto& candidates = state->candidates;
+    const auto& transactions = block.transactions;
+
+    for (size_t tx = 0; tx < transactions.size(); ++tx)
+    {
+        const auto& outputs = transactions[tx].outputs;
+
+        for (size_t index = 0; index + 1 < outputs.size(); ++index)
+        {
+            const auto& stealth_script = outputs[index].script;
+
+            stealth_candidate candidate;
+            if (!to_stealth_prefix(candidate.prefix, stealth_script) ||
+                !extract_ephemeral_key(candidate.ephemeral_key, stealth_script))
+                continue;
+
+            const auto address = payment_address::extract(
+                outputs[index + 1].script, p2kh_version_);
+
+            if (!address || address.version() != p2kh_version_)
+                continue;
+
+            candidate.transaction = tx;
+            candidate.index = static_cast<uint32_t>(index + 1);
+            candidate.payment = address.hash();
+            candidates.push_back(candidate);
+        }
+    }
+
+    // Pair each candidate with the keys whose filter it satisfies.
+    key_indexes keys;
+    for (size_t candidate = 0; candidate < candidates.size(); ++candidate)
+    {
+        pair(keys, candidates[candidate].prefix);
+
+        for (const auto key: keys)
+            state->pairings.push_back({ candidate, key, false, {} });
+    }
+
+    return state;
+}
+
+// Claim and test pairings until none remain, each costs two point
+// multiplications. The keys are not referenced once all are claimed.
+void stealth_scanner::match(scan_state& state,
+    const stealth_scan_key::list& keys)
+{
+    const auto count = state.pairings.size();
+
+    for (auto pair = state.next++; pair < count; pair = state.next++)
+    {
+        auto& pairing = state.pairings[pair];
+        const auto& key = keys[pairing.key];
+        const auto& candidate = state.candidates[pairing.candidate];
+
+        pairing.matched = uncover_stealth(pairing.stealth_key,
+            candidate.ephemeral_key, key.scan_secret, key.spend_key) &&
+            bitcoin_short_hash(pairing.stealth_key) == candidate.payment;
+
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (++state.completed == count)
+            state.done.notify_all();
+    }
+}
+
+// Emit the matches in block order, hashing only matched transactions.
+stealth_match::list stealth_scanner::emit(const scan_state& state,
+    const block& block) const
+{
+    stealth_match::list matches;
+    for (const auto& pairing: state.pairings)
+    {
+        if (!pairing.matched)
+            continue;
+
+        const auto& candidate = state.candidates[pairing.candidate];
+        const auto& tx = block.transactions[candidate.transaction];
+
+        matches.push_back(
+        {
+            pairing.key, tx.hash(), candidate.index,
+            candidate.ephemeral_key, pairing.stealth_key
+        });
+    }
+
+    return matches;
+}
+
+stealth_match::list stealth_scanner::scan(const block& block,
+    size_t threads) const
+{
+    const auto state = prepare(block);
+    const auto count = state->pairings.size();
+
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    threads = std::min(threads, count);
+
+    const auto work = [this, &state]()
+    {
+        match(*state, keys_);
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t worker = 1; worker < threads; ++worker)
+        workers.emplace_back(work);
+
+    work();
+
+    for (auto& worker: workers)
+        worker.join();
+
+    return emit(*state, block);
+}
+
+stealth_match::list stealth_scanner::scan(const block& block,
+    scheduler& executor) const
+{
+    const auto state = prepare(block);
+    const auto count = state->pairings.size();
+    const auto tasks = std::min(executor.size(), count);
+    const auto& keys = keys_;
+
+    // A task that starts after the scan finds nothing left to claim.
+    const auto work = [state, &keys]()
+    {
+        match(*state, keys);
+    };
+
+    // The caller also works, so this completes even if tasks are refused.
+    for (size_t task = 1; task < tasks; ++task)
+        if (!executor.post(work))
+            break;
+
+    work();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state, count]()
+    {
+        return state->completed == count;
+    });
+
+    lock.unlock();
+    return emit(*state, block);
+}
+
+} // namespace wallet
+} // namespace libbitcoin
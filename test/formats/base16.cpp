@@ -81,4 +81,62 @@ BOOST_AUTO_TEST_CASE(base16_array_test)
     BOOST_REQUIRE(converted == expected);
 }
 
+BOOST_AUTO_TEST_CASE(base16_encode_all_bytes_test)
+{
+    data_chunk data;
+    std::string expected;
+    static const auto digits = "0123456789abcdef";
+    for (size_t value = 0; value < 256; ++value)
+    {
+        data.push_back(static_cast<uint8_t>(value));
+        expected += digits[value >> 4];
+        expected += digits[value & 0x0f];
+    }
+
+    BOOST_REQUIRE_EQUAL(encode_base16(data), expected);
+
+    data_chunk decoded;
+    BOOST_REQUIRE(decode_base16(decoded, expected));
+    BOOST_REQUIRE(decoded == data);
+}
+
+BOOST_AUTO_TEST_CASE(base16_decode_upper_case_test)
+{
+    data_chunk data;
+    BOOST_REQUIRE(decode_base16(data, "01FF42Bc"));
+    BOOST_REQUIRE_EQUAL(encode_base16(data), "01ff42bc");
+}
+
+BOOST_AUTO_TEST_CASE(base16_decode_invalid_character_unchanged_test)
+{
+    data_chunk data{ 0x2a };
+    BOOST_REQUIRE(!decode_base16(data, "01fg"));
+    BOOST_REQUIRE(!decode_base16(data, std::string("01\0f", 4)));
+    BOOST_REQUIRE(data == data_chunk{ 0x2a });
+}
+
+BOOST_AUTO_TEST_CASE(base16_encode_caller_buffer_test)
+{
+    const data_chunk data{ 0x01, 0xff, 0x42, 0xbc };
+    char buffer[9] = "xxxxxxxx";
+    encode_base16(buffer, data);
+    BOOST_REQUIRE_EQUAL(std::string(buffer), "01ff42bc");
+
+    std::string out("reused");
+    encode_base16(out, data);
+    BOOST_REQUIRE_EQUAL(out, "01ff42bc");
+}
+
+BOOST_AUTO_TEST_CASE(base16_decode_caller_buffer_test)
+{
+    const std::string hex("01ff42bc");
+    uint8_t buffer[4] = { 0 };
+    BOOST_REQUIRE(decode_base16(buffer, sizeof(buffer), hex.data(),
+        hex.size()));
+    BOOST_REQUIRE_EQUAL(encode_base16(data_chunk(buffer, buffer + 4)), hex);
+
+    // The output size must be exactly half the input size.
+    BOOST_REQUIRE(!decode_base16(buffer, 3, hex.data(), hex.size()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
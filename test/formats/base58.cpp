@@ -67,6 +67,80 @@ BOOST_AUTO_TEST_CASE(base58_address_test)
     BOOST_REQUIRE(decoded == pubkey);
 }
 
+BOOST_AUTO_TEST_CASE(base58_long_leading_zeros_round_trip_test)
+{
+    // Every length from zero exercises each partial limb.
+    data_chunk data;
+    for (size_t size = 0; size < 80; ++size)
+    {
+        data_chunk decoded;
+        const auto encoded = encode_base58(data);
+        BOOST_REQUIRE(decode_base58(decoded, encoded));
+        BOOST_REQUIRE(decoded == data);
+        data.push_back(static_cast<uint8_t>(size % 3 == 0 ? 0 : size * 37));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(base58_decode_invalid_character_unchanged_test)
+{
+    data_chunk decoded{ 0x2a };
+    const std::string invalid = "19TbMSWwHvnxAKy12iNm3KdbGfzfaMFVi0";
+    BOOST_REQUIRE(!decode_base58(decoded, invalid));
+    BOOST_REQUIRE(decoded == data_chunk{ 0x2a });
+}
+
+BOOST_AUTO_TEST_CASE(base58_check_address_test)
+{
+    const data_chunk payload
+    {
+        {
+            0x00, 0x5c, 0xc8, 0x7f, 0x4a, 0x3f, 0xdf, 0xe3,
+            0xa2, 0x34, 0x6b, 0x69, 0x53, 0x26, 0x7c, 0xa8,
+            0x67, 0x28, 0x26, 0x30, 0xd3
+        }
+    };
+    const std::string address = "19TbMSWwHvnxAKy12iNm3KdbGfzfaMFViT";
+    BOOST_REQUIRE_EQUAL(encode_base58_check(payload), address);
+
+    data_chunk decoded;
+    BOOST_REQUIRE(decode_base58_check(decoded, address));
+    BOOST_REQUIRE(decoded == payload);
+}
+
+BOOST_AUTO_TEST_CASE(base58_check_bad_checksum_test)
+{
+    data_chunk decoded;
+    BOOST_REQUIRE(!decode_base58_check(decoded,
+        "19TbMSWwHvnxAKy12iNm3KdbGfzfaMFViU"));
+    BOOST_REQUIRE(!decode_base58_check(decoded, "1"));
+}
+
+BOOST_AUTO_TEST_CASE(base58_check_batch_round_trip_test)
+{
+    const data_stack payloads
+    {
+        data_chunk{ 0x00 },
+        data_chunk{ 0x05, 0x01, 0x02, 0x03 },
+        data_chunk{}
+    };
+
+    const auto encoded = encode_base58_check(payloads);
+    BOOST_REQUIRE_EQUAL(encoded.size(), payloads.size());
+    BOOST_REQUIRE_EQUAL(encoded[1], encode_base58_check(payloads[1]));
+
+    data_stack decoded;
+    BOOST_REQUIRE(decode_base58_check(decoded, encoded));
+    BOOST_REQUIRE(decoded == payloads);
+}
+
+BOOST_AUTO_TEST_CASE(base58_check_batch_invalid_unchanged_test)
+{
+    data_stack decoded{ data_chunk{ 0x2a } };
+    const string_list encoded{ encode_base58_check(data_chunk{ 0x01 }), "0" };
+    BOOST_REQUIRE(!decode_base58_check(decoded, encoded));
+    BOOST_REQUIRE_EQUAL(decoded.size(), 1u);
+}
+
 BOOST_AUTO_TEST_CASE(is_b58)
 {
     const std::string base58_chars = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
@@ -17,6 +17,7 @@
  * You should have received a copy of the GNU Affero General Public License
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
+#include <sstream>
 #include <boost/test/unit_test.hpp>
 
 #include <bitcoin/bitcoin.hpp>
@@ -85,4 +86,45 @@ BOOST_AUTO_TEST_CASE(decode_base64_invalid_test)
     BOOST_REQUIRE(!decode_base64(result, "!@#$%^&*()"));
 }
 
+BOOST_AUTO_TEST_CASE(decode_base64_inner_padding_invalid_test)
+{
+    data_chunk result;
+    BOOST_REQUIRE(!decode_base64(result, "TW=uLCBF"));
+    BOOST_REQUIRE(!decode_base64(result, "TWF=LCBF"));
+}
+
+BOOST_AUTO_TEST_CASE(encode_base64_stream_test)
+{
+    // The data spans several stream chunks and ends in a partial group.
+    data_chunk data(10000);
+    for (size_t index = 0; index < data.size(); ++index)
+        data[index] = static_cast<uint8_t>(index * 7);
+
+    std::stringstream unencoded(std::string(data.begin(), data.end()));
+    std::stringstream encoded;
+    BOOST_REQUIRE(encode_base64(encoded, unencoded));
+    BOOST_REQUIRE_EQUAL(encoded.str(), encode_base64(data));
+
+    std::stringstream decoded;
+    BOOST_REQUIRE(decode_base64(decoded, encoded));
+    BOOST_REQUIRE_EQUAL(decoded.str(), std::string(data.begin(), data.end()));
+}
+
+BOOST_AUTO_TEST_CASE(decode_base64_stream_padded_test)
+{
+    std::stringstream encoded(BASE64_BOOK);
+    std::stringstream decoded;
+    const data_chunk expected(BASE64_DATA_BOOK);
+    BOOST_REQUIRE(decode_base64(decoded, encoded));
+    BOOST_REQUIRE_EQUAL(decoded.str(),
+        std::string(expected.begin(), expected.end()));
+}
+
+BOOST_AUTO_TEST_CASE(decode_base64_stream_invalid_test)
+{
+    std::stringstream encoded("!@#$%^&*()");
+    std::stringstream decoded;
+    BOOST_REQUIRE(!decode_base64(decoded, encoded));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -17,6 +17,7 @@
  * You should have received a copy of the GNU Affero General Public License
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
+#include <sstream>
 #include <boost/test/test_tools.hpp>
 #include <boost/test/unit_test_suite.hpp>
 #include <bitcoin/bitcoin.hpp>
@@ -98,4 +99,39 @@ BOOST_AUTO_TEST_CASE(decode_base85_outside_alphabet_test)
     BOOST_REQUIRE(result == data_chunk({ 0, 0, 0, 0 }));
 }
 
+BOOST_AUTO_TEST_CASE(base85_stream_round_trip_test)
+{
+    // The data spans several stream chunks.
+    data_chunk data(10000);
+    for (size_t index = 0; index < data.size(); ++index)
+        data[index] = static_cast<uint8_t>(index * 7);
+
+    std::string expected;
+    BOOST_REQUIRE(encode_base85(expected, data));
+
+    std::stringstream unencoded(std::string(data.begin(), data.end()));
+    std::stringstream encoded;
+    BOOST_REQUIRE(encode_base85(encoded, unencoded));
+    BOOST_REQUIRE_EQUAL(encoded.str(), expected);
+
+    std::stringstream decoded;
+    BOOST_REQUIRE(decode_base85(decoded, encoded));
+    BOOST_REQUIRE_EQUAL(decoded.str(), std::string(data.begin(), data.end()));
+}
+
+BOOST_AUTO_TEST_CASE(encode_base85_stream_invalid_length_test)
+{
+    const data_chunk data(BASE85_DECODED_INVALID);
+    std::stringstream unencoded(std::string(data.begin(), data.end()));
+    std::stringstream encoded;
+    BOOST_REQUIRE(!encode_base85(encoded, unencoded));
+}
+
+BOOST_AUTO_TEST_CASE(decode_base85_stream_invalid_char_test)
+{
+    std::stringstream encoded(BASE85_ENCODED_INVALID_CHAR);
+    std::stringstream decoded;
+    BOOST_REQUIRE(!decode_base85(decoded, encoded));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -19,6 +19,7 @@
  */
 #include "hash.hpp"
 
+#include <unordered_set>
 #include <boost/test/unit_test.hpp>
 #include <bitcoin/bitcoin.hpp>
 #include "../chain/genesis_block.hpp"
@@ -99,4 +100,52 @@ BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512_test)
     }
 }
 
+BOOST_AUTO_TEST_CASE(std_hash__hash_digest__leading_word)
+{
+    const auto digest = bitcoin_hash(to_chunk("hash"));
+    const auto expected = from_little_endian_unsafe<size_t>(digest.begin());
+    BOOST_REQUIRE_EQUAL(std::hash<hash_digest>()(digest), expected);
+}
+
+BOOST_AUTO_TEST_CASE(std_hash__short_hash__leading_word)
+{
+    const auto digest = bitcoin_short_hash(to_chunk("hash"));
+    const auto expected = from_little_endian_unsafe<size_t>(digest.begin());
+    BOOST_REQUIRE_EQUAL(std::hash<short_hash>()(digest), expected);
+}
+
+BOOST_AUTO_TEST_CASE(salted_hash__same_salt__same_value)
+{
+    const auto digest = bitcoin_hash(to_chunk("hash"));
+    BOOST_REQUIRE_EQUAL(salted_hash(42)(digest), salted_hash(42)(digest));
+    BOOST_REQUIRE(salted_hash(42)(digest) != salted_hash(43)(digest));
+}
+
+BOOST_AUTO_TEST_CASE(salted_hash__default_salts__different_values)
+{
+    // The salts are independent 64 bit draws, equal with probability 2^-64.
+    const auto digest = bitcoin_hash(to_chunk("hash"));
+    const salted_hash first;
+    const salted_hash second;
+    BOOST_REQUIRE(first(digest) != second(digest));
+}
+
+BOOST_AUTO_TEST_CASE(salted_hash__trailing_bytes__significant)
+{
+    auto digest = bitcoin_short_hash(to_chunk("hash"));
+    const salted_hash hasher(42);
+    const auto value = hasher(digest);
+    digest.back() ^= 0x01;
+    BOOST_REQUIRE(hasher(digest) != value);
+}
+
+BOOST_AUTO_TEST_CASE(salted_hash__unordered_set__found)
+{
+    const auto first = bitcoin_hash(to_chunk("first"));
+    const auto second = bitcoin_hash(to_chunk("second"));
+    std::unordered_set<hash_digest, salted_hash> digests{ first };
+    BOOST_REQUIRE_EQUAL(digests.count(first), 1u);
+    BOOST_REQUIRE_EQUAL(digests.count(second), 0u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include "../chain/genesis_block.hpp"
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(hash_context_tests)
+
+struct hash_vector
+{
+    std::string input, result;
+};
+
+typedef std::vector<hash_vector> hash_vector_list;
+
+// A sample of the vectors of the hash tests.
+static const hash_vector_list sha1_vectors
+{{
+    {"", "da39a3ee5e6b4b0d3255bfef95601890afd80709"},
+    {"27ed20cb2fa1c9093ebf82427b2abff42cbd", "6a56c8684a4a5f37fee6d91526696aded7c0aa0a"},
+    {"ddba0a9bc3e53d6ef1c34c11031b54fdce18d54d0c2fb59fc80f0af4314e6916d0b0c5ae9ad8", "68e277e7fa9bc9d5ccfbceb08f57cf83fde883c0"},
+    {"aa9224a8e046e5b2", "ff409fff25b6ae55ac96994427eab6eaafd67559"}
+}};
+
+static const hash_vector_list ripemd160_vectors
+{{
+    {"", "9c1185a5c5e9fc54612808977ee8f548b2258d31"},
+    {"d5c2b51c22c73a03f316c980880a4ce564e80ed716d54d54ddc43181c8f0512617492f37894640940b1184e14d", "306e7d59121745f5d570c5aef029f521276455ce"},
+    {"327b8d8ec5d615581e334abdc90dc86f647e0e6e0c136015ef7307d83a2d72", "cc8e4f0af6057cff56cca797216cf312bb47da73"},
+    {"d3d9a60e3dc1f5ced2a961786f", "9b7378b66961a4103fa851ee5533acda4bf27b81"}
+}};
+
+static const hash_vector_list sha256_vectors
+{{
+    {"", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+    {"f0d5e1ba902e341a58320a08078af4311e1291dcffd97f00c06988e0e26a071832", "1f23e6ce087e16c4f3585fbe89a4be22961b413076eea1621a81fefaf0c33ecc"},
+    {"a5c082e4489c6aa415a961a1e2d0cbf12ed671e5d10d97fb6e63b852b056396670c336d21c75eca4ab0527023b59656a2136", "ad794747682bf286993167ba8b46a0c2b3ad888b91f2917e29832bee1261fcf0"},
+    {"c7cbf76a7f875446a32bc8c2a7ce295e1acf85eb10ad66c682b154f08acaa10262ef", "997b848f26a6de7efd214c47f0d56dc95b656ec519ebded493f51c2f5166dbb6"}
+}};
+
+BOOST_AUTO_TEST_CASE(hash_context__sha1__split_input__matches_sha1_hash)
+{
+    for (const auto& result: sha1_vectors)
+    {
+        data_chunk data;
+        BOOST_REQUIRE(decode_base16(data, result.input));
+        const auto half = data.size() / 2;
+
+        sha1_context context;
+        context.update(data.data(), half);
+        context.update(data.data() + half, data.size() - half);
+        BOOST_REQUIRE_EQUAL(encode_base16(context.finalize()), result.result);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hash_context__ripemd160__split_input__matches_ripemd160_hash)
+{
+    for (const auto& result: ripemd160_vectors)
+    {
+        data_chunk data;
+        BOOST_REQUIRE(decode_base16(data, result.input));
+        const auto half = data.size() / 2;
+
+        ripemd160_context context;
+        context.update(data.data(), half);
+        context.update(data.data() + half, data.size() - half);
+        BOOST_REQUIRE_EQUAL(encode_base16(context.finalize()), result.result);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hash_context__sha256__split_input__matches_sha256_hash)
+{
+    for (const auto& result: sha256_vectors)
+    {
+        data_chunk data;
+        BOOST_REQUIRE(decode_base16(data, result.input));
+        const auto half = data.size() / 2;
+
+        sha256_context context;
+        context.update(data.data(), half);
+        context.update(data.data() + half, data.size() - half);
+        BOOST_REQUIRE_EQUAL(encode_base16(context.finalize()), result.result);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hash_context__sha512__split_input__matches_sha512_hash)
+{
+    const data_chunk chunk{ 'd', 'a', 't', 'a' };
+    sha512_context context;
+    context.update(data_chunk{ 'd', 'a' });
+    context.update(data_chunk{ 't', 'a' });
+    BOOST_REQUIRE(context.finalize() == sha512_hash(chunk));
+}
+
+BOOST_AUTO_TEST_CASE(hash_context__hmac_sha256__reset__reuses_key)
+{
+    const data_chunk chunk{ 'd', 'a', 't', 'a' };
+    const data_chunk key{ 'k', 'e', 'y' };
+    hmac_sha256_context context(key);
+    context.update(data_chunk{ 'x' });
+    context.reset();
+    context.update(chunk);
+    BOOST_REQUIRE_EQUAL(encode_base16(context.finalize()), "5031fe3d989c6d1537a013fa6e739da23463fdaec3b70137d828e36ace221bd0");
+
+    // Finalize also resets to the keyed state.
+    context.update(chunk);
+    BOOST_REQUIRE(context.finalize() == hmac_sha256_hash(chunk, key));
+}
+
+BOOST_AUTO_TEST_CASE(hash_context__hmac_sha512__split_input__matches_hmac_sha512_hash)
+{
+    const data_chunk key{ 'k', 'e', 'y' };
+    hmac_sha512_context context(key);
+    context.update(data_chunk{ 'd', 'a' });
+    context.update(data_chunk{ 't', 'a' });
+    BOOST_REQUIRE_EQUAL(encode_base16(context.finalize()), "3c5953a18f7303ec653ba170ae334fafa08e3846f2efe317b87efce82376253cb52a8c31ddcde5a3a2eee183c2b34cb91f85e64ddbc325f7692b199473579c58");
+}
+
+BOOST_AUTO_TEST_CASE(hash_context__bitcoin__copy__preserves_midstate)
+{
+    const data_chunk prefix{ 'p', 'r', 'e', 'f', 'i', 'x' };
+    bitcoin_hash_context midstate;
+    midstate.update(prefix);
+
+    for (uint8_t suffix = 0; suffix < 3; ++suffix)
+    {
+        auto context = midstate;
+        context.write_byte(suffix);
+        const auto expected = build_chunk({ prefix, to_array(suffix) });
+        BOOST_REQUIRE(context.finalize() == bitcoin_hash(expected));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hash_context__bitcoin__to_data__matches_serialized_hash)
+{
+    const auto genesis = genesis_block();
+    const auto& coinbase = genesis.transactions.front();
+
+    bitcoin_hash_context context;
+    coinbase.to_data(context);
+    BOOST_REQUIRE(context.finalize() == bitcoin_hash(coinbase.to_data()));
+
+    genesis.header.to_data(context, false);
+    BOOST_REQUIRE_EQUAL(encode_hash(context.finalize()), "000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+}
+
+BOOST_AUTO_TEST_CASE(hash_context__bitcoin__hash_type_code__matches_appended_serialization)
+{
+    const auto genesis = genesis_block();
+    const auto& coinbase = genesis.transactions.front();
+    static const uint32_t hash_type_code = 0x01;
+
+    auto serialized = coinbase.to_data();
+    extend_data(serialized, to_little_endian(hash_type_code));
+    BOOST_REQUIRE(coinbase.hash(hash_type_code) == bitcoin_hash(serialized));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -17,6 +17,7 @@
  * You should have received a copy of the GNU Affero General Public License
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
+#include <string>
 #include <boost/test/unit_test.hpp>
 #include <bitcoin/bitcoin.hpp>
 
@@ -40,6 +41,148 @@ BOOST_AUTO_TEST_CASE(hash_number__simple__test)
     BOOST_REQUIRE(!(our_value > target));
 }
 
+BOOST_AUTO_TEST_CASE(hash_number__compact__round_trip__unchanged)
+{
+    hash_number target;
+    BOOST_REQUIRE(target.set_compact(0x1b0404cb));
+    BOOST_REQUIRE_EQUAL(target.compact(), 0x1b0404cbu);
+    BOOST_REQUIRE_EQUAL(encode_base16(target.hash()),
+        "000000000000000000000000000000000000000000000000cb04040000000000");
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__set_compact__negative__false)
+{
+    hash_number target;
+    BOOST_REQUIRE(!target.set_compact(0x04923456));
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__set_compact__overflow__false)
+{
+    hash_number target;
+    BOOST_REQUIRE(!target.set_compact(0xff123456));
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__work__minimum_difficulty__expected)
+{
+    hash_number target;
+    BOOST_REQUIRE(target.set_compact(max_work_bits));
+
+    // The work for a target is 2^256 / (target + 1).
+    const auto work = (~target / (target + 1)) + 1;
+    BOOST_REQUIRE(work == 0x100010001);
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__divide__wide_divisor__expected)
+{
+    // 2^200 / (2^100 + 1) = 2^100 - 1, remainder 1.
+    const auto dividend = hash_number(1) << 200;
+    const auto divisor = (hash_number(1) << 100) + 1;
+    const auto quotient = dividend / divisor;
+    BOOST_REQUIRE_EQUAL(encode_base16(quotient.hash()),
+        "ffffffffffffffffffffffff0f00000000000000000000000000000000000000");
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__divide__small_divisor__expected)
+{
+    auto number = hash_number(0xffffffffffffffff) << 64;
+    number /= 0xffffffff;
+    number *= 0xffffffff;
+    BOOST_REQUIRE_EQUAL(encode_base16(number.hash()),
+        "0000000000000000ffffffffffffffff00000000000000000000000000000000");
+}
+
+// uint256_t
+// ----------------------------------------------------------------------------
+
+static std::string to_hex(const uint256_t& number)
+{
+    return encode_base16(data_chunk(number.begin(), number.end()));
+}
+
+static uint256_t make_uint256(uint64_t limb3, uint64_t limb2, uint64_t limb1,
+    uint64_t limb0)
+{
+    return (uint256_t(limb3) << 192) | (uint256_t(limb2) << 128) |
+        (uint256_t(limb1) << 64) | uint256_t(limb0);
+}
+
+BOOST_AUTO_TEST_CASE(uint256__add__carry_across_limbs__expected)
+{
+    const auto sum = uint256_t(0xffffffffffffffff) + uint256_t(1);
+    BOOST_REQUIRE_EQUAL(to_hex(sum),
+        "0000000000000000010000000000000000000000000000000000000000000000");
+}
+
+BOOST_AUTO_TEST_CASE(uint256__subtract__borrow__wraps)
+{
+    BOOST_REQUIRE(uint256_t(0) - uint256_t(1) == ~uint256_t(0));
+    BOOST_REQUIRE(make_uint256(1, 0, 0, 0) - uint256_t(1) ==
+        make_uint256(0, ~0ull, ~0ull, ~0ull));
+}
+
+BOOST_AUTO_TEST_CASE(uint256__multiply__full_width__wraps_expected)
+{
+    // (2^128 - 1)^2 mod 2^256 = 2^256 - 2^129 + 1.
+    const auto number = (uint256_t(1) << 128) - uint256_t(1);
+    BOOST_REQUIRE_EQUAL(to_hex(number * number),
+        "01000000000000000000000000000000feffffffffffffffffffffffffffffff");
+}
+
+BOOST_AUTO_TEST_CASE(uint256__divide__add_back__expected)
+{
+    // The first estimated quotient digit is one too large (add back step).
+    const auto dividend = make_uint256(0, 0, 0x7fffffff80000000, 0);
+    const auto divisor = make_uint256(0, 0, 0x80000000, 1);
+    BOOST_REQUIRE(dividend / divisor == uint256_t(0xfffffffe));
+}
+
+BOOST_AUTO_TEST_CASE(uint256__divide__zero__throws)
+{
+    BOOST_REQUIRE_THROW(uint256_t(42) / uint256_t(0), uint_error);
+}
+
+BOOST_AUTO_TEST_CASE(uint256__divide__smaller_dividend__zero)
+{
+    BOOST_REQUIRE(uint256_t(41) / uint256_t(42) == 0);
+    BOOST_REQUIRE(uint256_t(42) / uint256_t(42) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(uint256__divide__pseudo_random__remainder_below_divisor)
+{
+    uint64_t seed = 42;
+    for (size_t test = 0; test < 256; ++test)
+    {
+        // Divisors of one to four limbs, over dividends of four limbs.
+        const auto dividend = make_uint256(splitmix64(seed), splitmix64(seed),
+            splitmix64(seed), splitmix64(seed));
+        auto divisor = make_uint256(splitmix64(seed), splitmix64(seed),
+            splitmix64(seed), splitmix64(seed));
+        divisor >>= static_cast<unsigned int>(test);
+        divisor |= 1;
+
+        const auto quotient = dividend / divisor;
+        const auto product = quotient * divisor;
+        BOOST_REQUIRE(product <= dividend);
+        BOOST_REQUIRE(dividend - product < divisor);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(uint256__compact__sign_bit__normalized)
+{
+    // A mantissa with its top bit set moves into the next byte.
+    BOOST_REQUIRE_EQUAL(uint256_t(0x80).GetCompact(), 0x02008000u);
+    BOOST_REQUIRE(uint256_t().SetCompact(0x02008000) == 0x80);
+}
+
+BOOST_AUTO_TEST_CASE(uint256__compact__mantissa_across_limbs__round_trip)
+{
+    // The mantissa of a ten byte value spans the first and second limbs.
+    uint256_t number;
+    number.SetCompact(0x0a123456);
+    BOOST_REQUIRE(number == make_uint256(0, 0, 0x1234, 0x5600000000000000));
+    BOOST_REQUIRE_EQUAL(number.GetCompact(), 0x0a123456u);
+}
+
 //BOOST_AUTO_TEST_CASE(hash_number__work__test)
 //{
 //    hash_number orphan_work = 0;
@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdexcept>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(scrypt_tests)
+
+// tools.ietf.org/html/rfc7914#section-12
+static const auto rfc7914_vector1 = "77d6576238657b203b19ca42c18a0497f16b4844e3074ae8dfdffa3fede21442fcd0069ded0948f8326a753a0fc81f17e8d3e0fb2e0d3628cf35e20c38d18906";
+static const auto rfc7914_vector2 = "fdbabe1c9d3472007856e7190d01e9fe7c6ad7cbc8237830e77376634b3731622eaf30d92e22a3886ff109279d9830dac727afb94a83ee6d8360cbdfa2cc0640";
+
+static data_chunk to_data(const std::string& text)
+{
+    return data_chunk(text.begin(), text.end());
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__context__rfc7914_vector1__expected)
+{
+    scrypt_context context(1);
+    const auto result = context.hash(data_chunk(), data_chunk(), 16, 1, 1, 64);
+    BOOST_REQUIRE_EQUAL(encode_base16(result), rfc7914_vector1);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__context__rfc7914_vector2_single_thread__expected)
+{
+    scrypt_context context(1);
+    const auto result = context.hash(to_data("password"), to_data("NaCl"),
+        1024, 16, 8, 64);
+    BOOST_REQUIRE_EQUAL(encode_base16(result), rfc7914_vector2);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__context__rfc7914_vector2_uneven_threads__expected)
+{
+    // Three threads do not divide the sixteen lanes evenly.
+    scrypt_context context(3);
+    const auto result = context.hash(to_data("password"), to_data("NaCl"),
+        1024, 16, 8, 64);
+    BOOST_REQUIRE_EQUAL(encode_base16(result), rfc7914_vector2);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__context__reused_across_parameters__expected)
+{
+    scrypt_context context(2);
+    const auto result1 = context.hash(to_data("password"), to_data("NaCl"),
+        1024, 16, 8, 64);
+    const auto result2 = context.hash(data_chunk(), data_chunk(), 16, 1, 1, 64);
+    const auto result3 = context.hash(to_data("password"), to_data("NaCl"),
+        1024, 16, 8, 64);
+    BOOST_REQUIRE_EQUAL(encode_base16(result1), rfc7914_vector2);
+    BOOST_REQUIRE_EQUAL(encode_base16(result2), rfc7914_vector1);
+    BOOST_REQUIRE_EQUAL(encode_base16(result3), rfc7914_vector2);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__context__clear__expected)
+{
+    scrypt_context context(1);
+    context.hash(data_chunk(), data_chunk(), 16, 1, 1, 64);
+    context.clear();
+    const auto result = context.hash(data_chunk(), data_chunk(), 16, 1, 1, 64);
+    BOOST_REQUIRE_EQUAL(encode_base16(result), rfc7914_vector1);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__context__zero_threads__hardware_concurrency)
+{
+    scrypt_context context(0);
+    BOOST_REQUIRE_GE(context.threads(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__context__non_power_of_two__throws)
+{
+    scrypt_context context;
+    BOOST_REQUIRE_THROW(context.hash(data_chunk(), data_chunk(), 15, 1, 1, 64),
+        std::runtime_error);
+}
+
+// The mix computes blocks in pairs, so N = 1 (a power of two) is rejected.
+BOOST_AUTO_TEST_CASE(scrypt__context__n_one__throws)
+{
+    scrypt_context context;
+    BOOST_REQUIRE_THROW(context.hash(data_chunk(), data_chunk(), 1, 1, 1, 64),
+        std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__context__zero_lanes__throws)
+{
+    scrypt_context context;
+    BOOST_REQUIRE_THROW(context.hash(data_chunk(), data_chunk(), 16, 0, 1, 64),
+        std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__scratch_size__bip38_parameters__at_least_16mb)
+{
+    BOOST_REQUIRE_GE(scrypt_context::scratch_size(16384, 8), 16777216u);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__scrypt__rfc7914_vector2__expected)
+{
+    const auto result = scrypt(to_data("password"), to_data("NaCl"), 1024,
+        16, 8, 64);
+    BOOST_REQUIRE_EQUAL(encode_base16(result), rfc7914_vector2);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__scrypt_array__rfc7914_vector2__expected)
+{
+    const auto result = scrypt<64>(to_data("password"), to_data("NaCl"),
+        1024, 16, 8);
+    BOOST_REQUIRE_EQUAL(encode_base16(result), rfc7914_vector2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
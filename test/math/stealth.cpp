@@ -152,4 +152,33 @@ BOOST_AUTO_TEST_CASE(bitfield_test4)
     BOOST_REQUIRE_EQUAL(prefix, compare);
 }
 
+BOOST_AUTO_TEST_CASE(create_stealth_data__threads__same_data_matching_filter)
+{
+    const binary_type filter("101011000011");
+    const data_chunk seed{ 0x01, 0x02, 0x03, 0x04, 0x05 };
+
+    ec_secret secret;
+    data_chunk stealth_data;
+    BOOST_REQUIRE(create_stealth_data(stealth_data, secret, filter, seed, 1));
+
+    ec_secret threaded_secret;
+    data_chunk threaded_stealth_data;
+    BOOST_REQUIRE(create_stealth_data(threaded_stealth_data, threaded_secret,
+        filter, seed, 4));
+    BOOST_REQUIRE(threaded_stealth_data == stealth_data);
+    BOOST_REQUIRE(threaded_secret == secret);
+
+    uint32_t prefix;
+    const auto ops = chain::operation::to_null_data_pattern(stealth_data);
+    const chain::script stealth_script{ ops };
+    BOOST_REQUIRE(to_stealth_prefix(prefix, stealth_script));
+    BOOST_REQUIRE(filter.is_prefix_of(prefix));
+
+    ec_compressed expected;
+    ec_compressed ephemeral;
+    BOOST_REQUIRE(secret_to_public(expected, secret));
+    BOOST_REQUIRE(extract_ephemeral_key(ephemeral, stealth_script));
+    BOOST_REQUIRE(ephemeral == expected);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::network;
+
+BOOST_AUTO_TEST_SUITE(trace_tests)
+
+static boost::filesystem::path temporary_trace()
+{
+    using namespace boost::filesystem;
+    return temp_directory_path() / unique_path("libbitcoin-%%%%-%%%%.trace");
+}
+
+static std::string to_command(const trace_record& record)
+{
+    return std::string(record.command.begin(), std::find(
+        record.command.begin(), record.command.end(), 0x00));
+}
+
+BOOST_AUTO_TEST_CASE(trace_record__to_data__roundtrip__expected)
+{
+    trace_record expected;
+    expected.timestamp = 1449000000000001;
+    expected.duration = 42;
+    expected.payload_size = 1000;
+    expected.event = trace_event::message_sent;
+    expected.port = 8333;
+    expected.ip = config::authority("1.2.240.1:8333").ip();
+    expected.command.fill(0x00);
+    expected.command[0] = 'i';
+    expected.command[1] = 'n';
+    expected.command[2] = 'v';
+
+    const auto data = expected.to_data();
+    BOOST_REQUIRE(data.size() == trace_record::serialized_size);
+
+    const auto result = trace_record::factory_from_data(data);
+    BOOST_REQUIRE_EQUAL(result.timestamp, expected.timestamp);
+    BOOST_REQUIRE_EQUAL(result.duration, expected.duration);
+    BOOST_REQUIRE_EQUAL(result.payload_size, expected.payload_size);
+    BOOST_REQUIRE(result.event == expected.event);
+    BOOST_REQUIRE_EQUAL(result.port, expected.port);
+    BOOST_REQUIRE(result.ip == expected.ip);
+    BOOST_REQUIRE_EQUAL(to_command(result), "inv");
+}
+
+BOOST_AUTO_TEST_CASE(trace__record__not_started__not_enabled)
+{
+    BOOST_REQUIRE(!trace::enabled());
+    trace::record(trace_event::message_sent, config::authority(), "ping", 8);
+}
+
+BOOST_AUTO_TEST_CASE(trace__read__wrapped__newest_oldest_first)
+{
+    const auto path = temporary_trace();
+    const config::authority peer("1.2.240.1:8333");
+    BOOST_REQUIRE(trace::start(path, 4));
+    BOOST_REQUIRE(trace::enabled());
+
+    for (size_t size = 0; size < 6; ++size)
+        trace::record(trace_event::message_received, peer, "tx", size, 7);
+
+    trace::record(trace_event::channel_stopped, peer, "", 0);
+    trace::stop();
+    BOOST_REQUIRE(!trace::enabled());
+
+    trace::list records;
+    BOOST_REQUIRE(trace::read(records, path));
+    boost::filesystem::remove(path);
+
+    // The capacity holds the four most recent of the seven records.
+    BOOST_REQUIRE_EQUAL(records.size(), 4u);
+    BOOST_REQUIRE_EQUAL(records[0].payload_size, 3u);
+    BOOST_REQUIRE_EQUAL(records[2].payload_size, 5u);
+    BOOST_REQUIRE_EQUAL(to_command(records[2]), "tx");
+    BOOST_REQUIRE_EQUAL(records[2].duration, 7u);
+    BOOST_REQUIRE(records[3].event == trace_event::channel_stopped);
+    BOOST_REQUIRE_EQUAL(records[3].port, 8333u);
+    BOOST_REQUIRE(records[3].ip == peer.ip());
+}
+
+BOOST_AUTO_TEST_CASE(trace__read__missing_file__false)
+{
+    trace::list records;
+    BOOST_REQUIRE(!trace::read(records, temporary_trace()));
+}
+
+BOOST_AUTO_TEST_CASE(trace__read__truncated_file__false)
+{
+    const auto path = temporary_trace();
+    BOOST_REQUIRE(trace::start(path, 4));
+    trace::record(trace_event::message_sent, config::authority(), "ping", 8);
+    trace::stop();
+
+    // The header still claims the full capacity of four records.
+    const auto size = boost::filesystem::file_size(path);
+    boost::filesystem::resize_file(path, size - trace_record::serialized_size);
+
+    trace::list records;
+    BOOST_REQUIRE(!trace::read(records, path));
+    boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(trace__ticks__successive__not_decreasing)
+{
+    const auto first = trace::ticks();
+    BOOST_REQUIRE_LE(first, trace::ticks());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
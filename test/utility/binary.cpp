@@ -472,4 +472,87 @@ BOOST_AUTO_TEST_CASE(prefix_to_bytes__two_bytes_leading_null_byte__round_trips)
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(binary__reference)
+
+static std::string to_bitstring(const binary_type& value)
+{
+    std::stringstream stream;
+    stream << value;
+    return stream.str();
+}
+
+static std::string make_bitstring(size_t size, size_t seed)
+{
+    std::string bits;
+    for (size_t bit = 0; bit < size; ++bit)
+        bits.push_back((bit * 7 + seed) % 5 < 2 ? '1' : '0');
+
+    return bits;
+}
+
+BOOST_AUTO_TEST_CASE(binary__word_operations__match_bitstring_reference)
+{
+    for (size_t size = 0; size < 150; size += 7)
+    {
+        for (size_t distance = 0; distance < 150; distance += 11)
+        {
+            const auto bits = make_bitstring(size, distance);
+            const auto tail = distance < size ? bits.substr(distance) : "";
+
+            binary_type left(bits);
+            left.shift_left(distance);
+            BOOST_REQUIRE_EQUAL(to_bitstring(left), tail);
+
+            binary_type right(bits);
+            right.shift_right(distance);
+            BOOST_REQUIRE_EQUAL(to_bitstring(right),
+                std::string(distance, '0') + bits);
+
+            binary_type part;
+            binary_type(bits).substring(part, distance, 9);
+            BOOST_REQUIRE_EQUAL(to_bitstring(part), tail.substr(0, 9));
+
+            const auto post = make_bitstring(distance, size);
+            binary_type appended(bits);
+            appended.append(binary_type(post));
+            BOOST_REQUIRE_EQUAL(to_bitstring(appended), bits + post);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(binary__append__self__doubled)
+{
+    binary_type instance("10110");
+    instance.append(instance);
+    BOOST_REQUIRE_EQUAL(to_bitstring(instance), "1011010110");
+    instance.prepend(instance);
+    BOOST_REQUIRE_EQUAL(to_bitstring(instance), "10110101101011010110");
+}
+
+BOOST_AUTO_TEST_CASE(binary__substring__in_place__expected)
+{
+    binary_type instance(20, data_chunk{ 0xAA, 0xBB, 0xCC });
+    instance.substring(instance, 10, 8);
+    BOOST_REQUIRE_EQUAL(to_bitstring(instance), "11101111");
+}
+
+BOOST_AUTO_TEST_CASE(binary__is_prefix_of__short_field__zero_padded)
+{
+    const data_chunk field{ 0xF0 };
+    BOOST_REQUIRE(binary_type("111100000").is_prefix_of(field));
+    BOOST_REQUIRE(!binary_type("111100001").is_prefix_of(field));
+    BOOST_REQUIRE(binary_type("1111").is_prefix_of(field));
+    BOOST_REQUIRE(!binary_type("1110").is_prefix_of(field));
+}
+
+BOOST_AUTO_TEST_CASE(binary__is_prefix_of__uint32__little_endian_bytes)
+{
+    const uint32_t field = 0x0df0adba;
+    BOOST_REQUIRE(binary_type("101110101010").is_prefix_of(field));
+    BOOST_REQUIRE(!binary_type("101110101011").is_prefix_of(field));
+    BOOST_REQUIRE(binary_type().is_prefix_of(field));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,178 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using std::placeholders::_1;
+using std::placeholders::_2;
+
+BOOST_AUTO_TEST_SUITE(callback_tests)
+
+struct target
+{
+    size_t sum(size_t value, const std::string& text)
+    {
+        return value + text.size();
+    }
+};
+
+BOOST_AUTO_TEST_CASE(callback__construct__default__empty)
+{
+    const callback<void()> instance;
+    BOOST_REQUIRE(!instance);
+    BOOST_REQUIRE(!instance.is_inline());
+    BOOST_REQUIRE_THROW(instance(), std::bad_function_call);
+}
+
+static size_t identity(size_t value)
+{
+    return value;
+}
+
+BOOST_AUTO_TEST_CASE(callback__construct__null_function_pointer__empty)
+{
+    size_t (*function)(size_t) = nullptr;
+    const callback<size_t(size_t)> instance(function);
+    BOOST_REQUIRE(!instance);
+    BOOST_REQUIRE_THROW(instance(42), std::bad_function_call);
+}
+
+BOOST_AUTO_TEST_CASE(callback__construct__function_pointer__invoked)
+{
+    const callback<size_t(size_t)> instance(&identity);
+    BOOST_REQUIRE(instance);
+    BOOST_REQUIRE_EQUAL(instance(42), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(callback__construct__empty_std_function__empty)
+{
+    const std::function<void()> function;
+    const callback<void()> instance(function);
+    BOOST_REQUIRE(!instance);
+}
+
+BOOST_AUTO_TEST_CASE(callback__construct__not_callable__not_constructible)
+{
+    typedef callback<size_t(size_t)> handler;
+    BOOST_REQUIRE((!std::is_constructible<handler, int>::value));
+    BOOST_REQUIRE((!std::is_constructible<handler, std::string>::value));
+    BOOST_REQUIRE((!std::is_constructible<handler, void(*)()>::value));
+    BOOST_REQUIRE((std::is_constructible<handler, size_t(*)(size_t)>::value));
+}
+
+BOOST_AUTO_TEST_CASE(callback__construct__bound_shared_pointer__inline)
+{
+    const auto instance = std::make_shared<target>();
+    const callback<size_t(size_t, const std::string&)> handler(
+        std::bind(&target::sum, instance, _1, _2));
+
+    BOOST_REQUIRE(handler);
+    BOOST_REQUIRE(handler.is_inline());
+    BOOST_REQUIRE_EQUAL(handler(40, "ab"), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(callback__construct__large_target__allocated)
+{
+    std::array<uint8_t, 128> buffer;
+    buffer.fill(0x2a);
+    const callback<uint8_t()> handler([buffer]() { return buffer.back(); });
+
+    BOOST_REQUIRE(handler);
+    BOOST_REQUIRE(!handler.is_inline());
+    BOOST_REQUIRE_EQUAL(handler(), 0x2a);
+}
+
+BOOST_AUTO_TEST_CASE(callback__move__inline__transferred)
+{
+    const auto instance = std::make_shared<target>();
+    callback<size_t(size_t, const std::string&)> source(
+        std::bind(&target::sum, instance, _1, _2));
+
+    auto handler = std::move(source);
+    BOOST_REQUIRE(!source);
+    BOOST_REQUIRE(handler);
+    BOOST_REQUIRE_EQUAL(instance.use_count(), 2);
+    BOOST_REQUIRE_EQUAL(handler(1, "a"), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(callback__move_assign__allocated__transferred)
+{
+    std::array<size_t, 32> buffer;
+    buffer.fill(7);
+    callback<size_t()> source([buffer]() { return buffer.front(); });
+
+    callback<size_t()> handler([]() { return size_t(0); });
+    handler = std::move(source);
+    BOOST_REQUIRE(!source);
+    BOOST_REQUIRE(!handler.is_inline());
+    BOOST_REQUIRE_EQUAL(handler(), 7u);
+}
+
+BOOST_AUTO_TEST_CASE(callback__destruct__target_released)
+{
+    const auto instance = std::make_shared<target>();
+
+    if (true)
+    {
+        const callback<size_t(size_t, const std::string&)> handler(
+            std::bind(&target::sum, instance, _1, _2));
+        BOOST_REQUIRE_EQUAL(instance.use_count(), 2);
+    }
+
+    BOOST_REQUIRE_EQUAL(instance.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(callback__copy__inline__target_copied)
+{
+    const auto instance = std::make_shared<target>();
+    const callback<size_t(size_t, const std::string&)> source(
+        std::bind(&target::sum, instance, _1, _2));
+
+    const auto handler = source;
+    BOOST_REQUIRE(source);
+    BOOST_REQUIRE(handler.is_inline());
+    BOOST_REQUIRE_EQUAL(instance.use_count(), 3);
+    BOOST_REQUIRE_EQUAL(handler(1, "a"), 2u);
+    BOOST_REQUIRE_EQUAL(source(2, "a"), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(callback__copy_assign__allocated__target_copied)
+{
+    std::array<size_t, 32> buffer;
+    buffer.fill(7);
+    const callback<size_t()> source([buffer]() { return buffer.back(); });
+
+    callback<size_t()> handler;
+    handler = source;
+    BOOST_REQUIRE(source);
+    BOOST_REQUIRE(!handler.is_inline());
+    BOOST_REQUIRE_EQUAL(handler(), 7u);
+    BOOST_REQUIRE_EQUAL(source(), 7u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
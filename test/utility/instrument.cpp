@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(instrument_tests)
+
+static metric test_counter("test.counter", metric_kind::counter);
+static metric test_histogram("test.histogram", metric_kind::histogram);
+
+static bool find(const instrument::snapshots& snapshots,
+    const std::string& name, metric_snapshot& out)
+{
+    for (const auto& snapshot: snapshots)
+    {
+        if (snapshot.name == name)
+        {
+            out = snapshot;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+BOOST_AUTO_TEST_CASE(metric__record__counter__count_and_sum)
+{
+    test_counter.reset();
+    test_counter.record();
+    test_counter.record(41);
+    const auto snapshot = test_counter.snapshot();
+    BOOST_REQUIRE_EQUAL(snapshot.name, "test.counter");
+    BOOST_REQUIRE(snapshot.kind == metric_kind::counter);
+    BOOST_REQUIRE_EQUAL(snapshot.count, 2u);
+    BOOST_REQUIRE_EQUAL(snapshot.sum, 42u);
+    BOOST_REQUIRE(snapshot.buckets.empty());
+    BOOST_REQUIRE_EQUAL(snapshot.mean(), 21.0);
+}
+
+BOOST_AUTO_TEST_CASE(metric__record__histogram__power_of_two_buckets)
+{
+    test_histogram.reset();
+    test_histogram.record(0);
+    test_histogram.record(1);
+    test_histogram.record(5);
+    test_histogram.record(6);
+    test_histogram.record(1000);
+    const auto snapshot = test_histogram.snapshot();
+    BOOST_REQUIRE_EQUAL(snapshot.count, 5u);
+    BOOST_REQUIRE_EQUAL(snapshot.sum, 1012u);
+    BOOST_REQUIRE(snapshot.buckets.size() == metric::bucket_count);
+    BOOST_REQUIRE_EQUAL(snapshot.buckets[0], 1u);
+    BOOST_REQUIRE_EQUAL(snapshot.buckets[1], 1u);
+    BOOST_REQUIRE_EQUAL(snapshot.buckets[3], 2u);
+    BOOST_REQUIRE_EQUAL(snapshot.buckets[10], 1u);
+    BOOST_REQUIRE_EQUAL(snapshot.percentile(0.0), 0u);
+    BOOST_REQUIRE_EQUAL(snapshot.percentile(0.5), 7u);
+    BOOST_REQUIRE_EQUAL(snapshot.percentile(1.0), 1023u);
+}
+
+BOOST_AUTO_TEST_CASE(metric__record__concurrent__all_counted)
+{
+    static const size_t threads = 4;
+    static const size_t records = 10000;
+    test_counter.reset();
+    std::vector<std::thread> workers;
+
+    for (size_t thread = 0; thread < threads; ++thread)
+        workers.emplace_back([]()
+        {
+            for (size_t record = 0; record < records; ++record)
+                test_counter.record(2);
+        });
+
+    for (auto& worker: workers)
+        worker.join();
+
+    const auto snapshot = test_counter.snapshot();
+    BOOST_REQUIRE_EQUAL(snapshot.count, threads * records);
+    BOOST_REQUIRE_EQUAL(snapshot.sum, 2 * threads * records);
+}
+
+BOOST_AUTO_TEST_CASE(scoped_timer__destruct__one_sample)
+{
+    test_histogram.reset();
+
+    if (true)
+    {
+        const scoped_timer timer(test_histogram);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const auto snapshot = test_histogram.snapshot();
+    BOOST_REQUIRE_EQUAL(snapshot.count, 1u);
+    BOOST_REQUIRE_GE(snapshot.sum, 1000000u);
+}
+
+BOOST_AUTO_TEST_CASE(instrument__snapshot__registered__found)
+{
+    test_counter.reset();
+    test_counter.record(7);
+    metric_snapshot snapshot;
+    BOOST_REQUIRE(find(instrument::snapshot(), "test.counter", snapshot));
+    BOOST_REQUIRE_EQUAL(snapshot.sum, 7u);
+    BOOST_REQUIRE(find(instrument::snapshot(), "test.histogram", snapshot));
+}
+
+BOOST_AUTO_TEST_CASE(instrument__start__period__snapshot_handled)
+{
+    test_counter.reset();
+    test_counter.record(3);
+    threadpool pool(1);
+    std::promise<uint64_t> promise;
+    const auto monitor = std::make_shared<instrument>(pool,
+        boost::posix_time::milliseconds(1), true);
+
+    monitor->start([&](const instrument::snapshots& snapshots)
+    {
+        metric_snapshot snapshot;
+        if (find(snapshots, "test.counter", snapshot))
+            promise.set_value(snapshot.sum);
+
+        monitor->stop();
+    });
+
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), 3u);
+    pool.shutdown();
+    pool.join();
+    BOOST_REQUIRE_EQUAL(test_counter.snapshot().count, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,134 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+#define TEST_DOMAIN "log_tests"
+
+// Restore the debug output, and so debug formatting, for later suites.
+class log_output_fixture
+{
+public:
+    log_output_fixture()
+      : debug_(log::output_function(log::level::debug))
+    {
+    }
+
+    ~log_output_fixture()
+    {
+        log::debug(TEST_DOMAIN).set_output_function(debug_);
+    }
+
+private:
+    log::functor debug_;
+};
+
+struct counted
+{
+    size_t& formatted;
+};
+
+static std::ostream& operator<<(std::ostream& out, const counted& value)
+{
+    ++value.formatted;
+    return out << "counted";
+}
+
+BOOST_FIXTURE_TEST_SUITE(log_tests, log_output_fixture)
+
+BOOST_AUTO_TEST_CASE(log__set_minimum__domain_below__not_formatted)
+{
+    std::vector<std::string> lines;
+    log::debug(TEST_DOMAIN).set_output_function(
+        [&lines](log::level, const std::string&, const std::string& body)
+        {
+            lines.push_back(body);
+        });
+
+    // Setting the function may write an empty line to the new function.
+    lines.clear();
+    size_t formatted = 0;
+    log::set_minimum(log::level::info, TEST_DOMAIN);
+    BOOST_REQUIRE(!log::enabled(log::level::debug, TEST_DOMAIN));
+    log::debug(TEST_DOMAIN) << counted{ formatted };
+    BOOST_REQUIRE_EQUAL(formatted, 0u);
+    BOOST_REQUIRE(lines.empty());
+
+    log::set_minimum(log::level::debug, TEST_DOMAIN);
+    BOOST_REQUIRE(log::enabled(log::level::debug, TEST_DOMAIN));
+    log::debug(TEST_DOMAIN) << counted{ formatted };
+    BOOST_REQUIRE_EQUAL(formatted, 1u);
+    BOOST_REQUIRE_EQUAL(lines.size(), 1u);
+    BOOST_REQUIRE_EQUAL(lines[0], "counted");
+}
+
+BOOST_AUTO_TEST_CASE(log__start_writer__lines__written_in_order)
+{
+    std::vector<std::string> lines;
+    log::debug(TEST_DOMAIN).set_output_function(
+        [&lines](log::level, const std::string&, const std::string& body)
+        {
+            lines.push_back(body);
+        });
+
+    // Setting the function may write an empty line to the new function.
+    lines.clear();
+    log::start_writer(16);
+
+    for (size_t line = 0; line < 10; ++line)
+        log::debug(TEST_DOMAIN) << line;
+
+    log::stop_writer();
+
+    // None are dropped, since the writer is never more than ten behind.
+    BOOST_REQUIRE_EQUAL(log::dropped(), 0u);
+    BOOST_REQUIRE_EQUAL(lines.size(), 10u);
+
+    for (size_t line = 0; line < lines.size(); ++line)
+        BOOST_REQUIRE_EQUAL(lines[line], std::to_string(line));
+}
+
+BOOST_AUTO_TEST_CASE(log__set_output_function__replaced_while_queued__written)
+{
+    std::vector<std::string> lines;
+    log::debug(TEST_DOMAIN).set_output_function(
+        [&lines](log::level, const std::string&, const std::string& body)
+        {
+            lines.push_back(body);
+        });
+
+    lines.clear();
+    log::start_writer(16);
+    log::debug(TEST_DOMAIN) << "queued";
+
+    // The queued line holds the function it was resolved to.
+    log::debug(TEST_DOMAIN).set_output_function(nullptr);
+    log::stop_writer();
+
+    BOOST_REQUIRE(!log::enabled(log::level::debug, TEST_DOMAIN));
+    BOOST_REQUIRE_EQUAL(lines.size(), 1u);
+    BOOST_REQUIRE_EQUAL(lines[0], "queued");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -17,6 +17,10 @@
  * You should have received a copy of the GNU Affero General Public License
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
 #include <boost/date_time.hpp>
 #include <bitcoin/bitcoin.hpp>
 #include <boost/test/unit_test.hpp>
@@ -84,4 +88,75 @@ BOOST_AUTO_TEST_CASE(random__pseudo_randomize__superminute_ratio_255__expected)
     BOOST_REQUIRE_GE(result, minimum);
 }
 
+BOOST_AUTO_TEST_CASE(random__xoshiro256__seed_42__expected)
+{
+    xoshiro256 generator(42);
+    BOOST_REQUIRE_EQUAL(generator(), 0x15780b2e0c2ec716u);
+    BOOST_REQUIRE_EQUAL(generator(), 0x6104d9866d113a7eu);
+    BOOST_REQUIRE_EQUAL(generator(), 0xae17533239e499a1u);
+}
+
+BOOST_AUTO_TEST_CASE(random__xoshiro256__same_seed__same_sequence)
+{
+    xoshiro256 generator1(7);
+    xoshiro256 generator2(7);
+    for (auto index = 0; index < 100; ++index)
+        BOOST_REQUIRE_EQUAL(generator1(), generator2());
+}
+
+BOOST_AUTO_TEST_CASE(random__xoshiro256__uniform_distribution__in_range)
+{
+    xoshiro256 generator(42);
+    std::uniform_int_distribution<int> distribution(-3, 3);
+    for (auto index = 0; index < 1000; ++index)
+    {
+        const auto value = distribution(generator);
+        BOOST_REQUIRE_GE(value, -3);
+        BOOST_REQUIRE_LE(value, 3);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(random__pseudo_random_fill__unaligned_size__filled)
+{
+    data_chunk chunk(37, 0x00);
+    pseudo_random_fill(chunk);
+
+    // The last word is partial, a zero byte here has probability 2^-40.
+    BOOST_REQUIRE(std::any_of(chunk.end() - 5, chunk.end(),
+        [](uint8_t byte) { return byte != 0x00; }));
+}
+
+BOOST_AUTO_TEST_CASE(random__secure_random_fill__unaligned_size__filled)
+{
+    data_chunk chunk(37, 0x00);
+    secure_random_fill(chunk);
+    BOOST_REQUIRE(std::any_of(chunk.end() - 5, chunk.end(),
+        [](uint8_t byte) { return byte != 0x00; }));
+}
+
+BOOST_AUTO_TEST_CASE(random__nonzero_secure_random__always__nonzero)
+{
+    BOOST_REQUIRE(nonzero_secure_random() != 0u);
+}
+
+BOOST_AUTO_TEST_CASE(random__pseudo_random__concurrent__distinct)
+{
+    static const size_t threads = 4;
+    std::vector<uint64_t> values(threads);
+    std::vector<std::thread> workers;
+
+    for (size_t thread = 0; thread < threads; ++thread)
+        workers.emplace_back([&values, thread]()
+        {
+            for (auto index = 0; index < 1000; ++index)
+                values[thread] ^= pseudo_random();
+        });
+
+    for (auto& worker: workers)
+        worker.join();
+
+    std::sort(values.begin(), values.end());
+    BOOST_REQUIRE(std::unique(values.begin(), values.end()) == values.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
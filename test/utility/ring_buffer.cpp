@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(ring_buffer_tests)
+
+BOOST_AUTO_TEST_CASE(ring_buffer__capacity__rounded_to_power_of_two)
+{
+    const ring_buffer<size_t> buffer(5);
+    BOOST_REQUIRE_EQUAL(buffer.capacity(), 8u);
+}
+
+BOOST_AUTO_TEST_CASE(ring_buffer__push__full__rejected)
+{
+    ring_buffer<std::string> buffer(2);
+    BOOST_REQUIRE(buffer.push("a"));
+    BOOST_REQUIRE(buffer.push("b"));
+    BOOST_REQUIRE(!buffer.push("c"));
+
+    std::string value;
+    BOOST_REQUIRE(buffer.pop(value));
+    BOOST_REQUIRE_EQUAL(value, "a");
+    BOOST_REQUIRE(buffer.push("d"));
+    BOOST_REQUIRE(buffer.pop(value));
+    BOOST_REQUIRE_EQUAL(value, "b");
+    BOOST_REQUIRE(buffer.pop(value));
+    BOOST_REQUIRE_EQUAL(value, "d");
+    BOOST_REQUIRE(!buffer.pop(value));
+}
+
+BOOST_AUTO_TEST_CASE(ring_buffer__producers__each_value_once)
+{
+    static const size_t producers = 4;
+    static const size_t values = 10000;
+    ring_buffer<size_t> buffer(64);
+    std::vector<std::thread> threads;
+
+    for (size_t producer = 0; producer < producers; ++producer)
+    {
+        threads.emplace_back([&buffer, producer]()
+        {
+            for (size_t value = 0; value < values; ++value)
+                while (!buffer.push(producer * values + value))
+                    std::this_thread::yield();
+        });
+    }
+
+    size_t value;
+    std::vector<bool> seen(producers * values, false);
+    for (size_t count = 0; count < seen.size();)
+    {
+        if (!buffer.pop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        BOOST_REQUIRE(!seen[value]);
+        seen[value] = true;
+        ++count;
+    }
+
+    for (auto& thread: threads)
+        thread.join();
+
+    BOOST_REQUIRE(!buffer.pop(value));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,203 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(scheduler_tests)
+
+BOOST_AUTO_TEST_CASE(scheduler__post__many__all_run)
+{
+    std::atomic<size_t> count(0);
+
+    if (true)
+    {
+        scheduler executor(4);
+        for (size_t task = 0; task < 1000; ++task)
+            executor.post([&count]() { ++count; });
+
+        executor.shutdown();
+        executor.join();
+    }
+
+    BOOST_REQUIRE_EQUAL(count.load(), 1000u);
+}
+
+BOOST_AUTO_TEST_CASE(scheduler__post__from_task__all_run)
+{
+    std::atomic<size_t> count(0);
+
+    if (true)
+    {
+        scheduler executor(2);
+        for (size_t task = 0; task < 100; ++task)
+        {
+            executor.post([&executor, &count]()
+            {
+                executor.post([&count]() { ++count; });
+                ++count;
+            });
+        }
+
+        // The destructor drains the nested tasks before joining.
+    }
+
+    BOOST_REQUIRE_EQUAL(count.load(), 200u);
+}
+
+BOOST_AUTO_TEST_CASE(scheduler__post__high_priority__runs_first)
+{
+    std::promise<void> gate;
+    auto opened = gate.get_future().share();
+    std::vector<std::string> order;
+
+    scheduler executor(1);
+    executor.post([opened]() { opened.wait(); });
+    executor.post([&order]() { order.push_back("normal"); });
+    executor.post([&order]() { order.push_back("high"); },
+        task_priority::high);
+
+    gate.set_value();
+    executor.shutdown();
+    executor.join();
+
+    BOOST_REQUIRE_EQUAL(order.size(), 2u);
+    BOOST_REQUIRE_EQUAL(order[0], "high");
+    BOOST_REQUIRE_EQUAL(order[1], "normal");
+}
+
+BOOST_AUTO_TEST_CASE(scheduler__post__external__runs_in_order)
+{
+    std::promise<void> gate;
+    auto opened = gate.get_future().share();
+    std::vector<size_t> order;
+
+    scheduler executor(1);
+    executor.post([opened]() { opened.wait(); });
+    for (size_t task = 0; task < 100; ++task)
+        executor.post([&order, task]() { order.push_back(task); });
+
+    gate.set_value();
+    executor.shutdown();
+    executor.join();
+
+    BOOST_REQUIRE_EQUAL(order.size(), 100u);
+    for (size_t task = 0; task < 100; ++task)
+        BOOST_REQUIRE_EQUAL(order[task], task);
+}
+
+BOOST_AUTO_TEST_CASE(scheduler__post__external_while_worker_posts__progresses)
+{
+    std::promise<void> done;
+    auto finished = done.get_future();
+    std::atomic<bool> stop(false);
+    std::function<void()> spin;
+
+    // The worker keeps its own deque busy until the external task runs.
+    scheduler executor(1);
+    spin = [&executor, &spin, &stop]()
+    {
+        if (!stop)
+            executor.post([&spin]() { spin(); });
+    };
+
+    executor.post([&spin]() { spin(); });
+    executor.post([&stop, &done]() { stop = true; done.set_value(); });
+
+    BOOST_REQUIRE(finished.wait_for(std::chrono::seconds(10)) ==
+        std::future_status::ready);
+    executor.shutdown();
+    executor.join();
+}
+
+BOOST_AUTO_TEST_CASE(scheduler__post__after_shutdown__refused)
+{
+    scheduler executor(1);
+    executor.shutdown();
+    executor.join();
+
+    auto ran = false;
+    BOOST_REQUIRE(!executor.post([&ran]() { ran = true; }));
+    BOOST_REQUIRE(!ran);
+}
+
+BOOST_AUTO_TEST_CASE(scheduler__post__after_abort__refused)
+{
+    scheduler executor(1);
+    executor.abort();
+    BOOST_REQUIRE(!executor.post([]() {}));
+    executor.join();
+}
+
+static void increment(std::atomic<size_t>& total, size_t value,
+    std::function<void(const code&)> handler)
+{
+    total += value;
+    handler(error::success);
+}
+
+BOOST_AUTO_TEST_CASE(scheduler__dispatcher_parallel__all_elements__cleared)
+{
+    threadpool pool(1);
+    scheduler executor(2);
+    dispatcher dispatch(pool, executor);
+
+    std::promise<code> completed;
+    std::atomic<size_t> total(0);
+    const std::vector<size_t> values{ 1, 2, 3, 4, 5 };
+    const auto handler = [&completed](const code& ec)
+    {
+        completed.set_value(ec);
+    };
+
+    // Each element and the synchronized handler are bound after the args.
+    dispatch.parallel(values, "sum", handler, increment, std::ref(total));
+
+    BOOST_REQUIRE_EQUAL(completed.get_future().get(), error::success);
+    BOOST_REQUIRE_EQUAL(total.load(), 15u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(scheduler__dispatcher_concurrent__stopped_scheduler__runs_on_service)
+{
+    threadpool pool(1);
+    scheduler executor(1);
+    executor.shutdown();
+    executor.join();
+    dispatcher dispatch(pool, executor);
+
+    std::promise<void> ran;
+    dispatch.concurrent([&ran]() { ran.set_value(); });
+    ran.get_future().get();
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
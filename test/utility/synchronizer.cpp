@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(synchronizer_tests)
+
+BOOST_AUTO_TEST_CASE(synchronizer__clearance__success_once)
+{
+    size_t calls = 0;
+    code result(error::operation_failed);
+    const auto handler = [&calls, &result](const code& ec)
+    {
+        ++calls;
+        result = ec;
+    };
+
+    auto call = synchronize(handler, 3, "test");
+    auto copy = call;
+    call(error::success);
+    copy(error::success);
+    BOOST_REQUIRE_EQUAL(calls, 0u);
+
+    call(error::success);
+    call(error::success);
+    BOOST_REQUIRE_EQUAL(calls, 1u);
+    BOOST_REQUIRE_EQUAL(result, error::success);
+}
+
+BOOST_AUTO_TEST_CASE(synchronizer__error__first_error_once)
+{
+    size_t calls = 0;
+    code result;
+    const auto handler = [&calls, &result](const code& ec)
+    {
+        ++calls;
+        result = ec;
+    };
+
+    auto call = synchronize(handler, 3, "test");
+    call(error::success);
+    call(error::channel_timeout);
+    call(error::operation_failed);
+    call(error::success);
+    BOOST_REQUIRE_EQUAL(calls, 1u);
+    BOOST_REQUIRE_EQUAL(result, error::channel_timeout);
+}
+
+BOOST_AUTO_TEST_CASE(synchronizer__suppress_errors__success_at_clearance)
+{
+    size_t calls = 0;
+    code result(error::operation_failed);
+    const auto handler = [&calls, &result](const code& ec)
+    {
+        ++calls;
+        result = ec;
+    };
+
+    auto call = synchronize(handler, 2, "test", true);
+    call(error::channel_timeout);
+    BOOST_REQUIRE_EQUAL(calls, 0u);
+
+    call(error::channel_timeout);
+    BOOST_REQUIRE_EQUAL(calls, 1u);
+    BOOST_REQUIRE_EQUAL(result, error::success);
+}
+
+BOOST_AUTO_TEST_CASE(synchronizer__concurrent_calls__handler_once)
+{
+    static const size_t threads = 4;
+    static const size_t calls_per_thread = 1000;
+
+    std::atomic<size_t> calls(0);
+    const auto handler = [&calls](const code&)
+    {
+        ++calls;
+    };
+
+    auto call = synchronize(handler, threads * calls_per_thread,
+        "test");
+
+    std::vector<std::thread> workers;
+    for (size_t thread = 0; thread < threads; ++thread)
+    {
+        workers.emplace_back([call]() mutable
+        {
+            for (size_t count = 0; count < calls_per_thread; ++count)
+                call(error::success);
+        });
+    }
+
+    for (auto& worker: workers)
+        worker.join();
+
+    BOOST_REQUIRE_EQUAL(calls.load(), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -337,6 +337,56 @@ BOOST_AUTO_TEST_SUITE_END()
 
 // ----------------------------------------------------------------------------
 
+BOOST_AUTO_TEST_SUITE(encrypted__decrypt_batch)
+
+// github.com/bitcoin/bips/blob/master/bip-0038.mediawiki
+static const encrypted_private_list batch_keys
+{
+    base58_literal("6PRVWUbkzzsbcVac2qwfssoUJAN1Xhrg6bNk8J7Nzm5H7kxEbn2Nh2ZoGg"),
+    base58_literal("6PYNKZ1EAgYgmQfmNVamxyXVWHzK5s6DGhwP4J5o44cvXdoY7sRzhtpUeo"),
+    base58_literal("6PfQu77ygVyJLZjfvMLyhLMQbYnu5uguoJJ4kMCLqWwPEdfpwANVS76gTX")
+};
+
+BOOST_AUTO_TEST_CASE(encrypted__decrypt_batch__empty__true)
+{
+    ek_decrypted_list out_secrets;
+    BOOST_REQUIRE(decrypt(out_secrets, {}, "TestingOneTwoThree"));
+    BOOST_REQUIRE(out_secrets.empty());
+}
+
+BOOST_AUTO_TEST_CASE(encrypted__decrypt_batch__vectors__expected)
+{
+    ek_decrypted_list out_secrets;
+    BOOST_REQUIRE(decrypt(out_secrets, batch_keys, "TestingOneTwoThree", 2));
+    BOOST_REQUIRE_EQUAL(out_secrets.size(), 3u);
+    BOOST_REQUIRE(out_secrets[0].valid);
+    BOOST_REQUIRE(!out_secrets[0].compressed);
+    BOOST_REQUIRE_EQUAL(out_secrets[0].version, 0x00);
+    BOOST_REQUIRE_EQUAL(encode_base16(out_secrets[0].secret), "cbf4b9f70470856bb4f40f80b87edb90865997ffee6df315ab166d713af433a5");
+    BOOST_REQUIRE(out_secrets[1].valid);
+    BOOST_REQUIRE(out_secrets[1].compressed);
+    BOOST_REQUIRE_EQUAL(encode_base16(out_secrets[1].secret), "cbf4b9f70470856bb4f40f80b87edb90865997ffee6df315ab166d713af433a5");
+    BOOST_REQUIRE(out_secrets[2].valid);
+    BOOST_REQUIRE_EQUAL(encode_base16(out_secrets[2].secret), "a43a940577f4e97f5c4d39eb14ff083a98187c64ea7c99ef7ce460833959a519");
+}
+
+BOOST_AUTO_TEST_CASE(encrypted__decrypt_batch__wrong_passphrase_key__false_invalid)
+{
+    auto keys = batch_keys;
+    keys.push_back(base58_literal("6PRNFFkZc2NZ6dJqFfhRoFNMR9Lnyj7dYGrzdgXXVMXcxoKTePPX1dWByq"));
+    ek_decrypted_list out_secrets;
+    BOOST_REQUIRE(!decrypt(out_secrets, keys, "TestingOneTwoThree", 1));
+    BOOST_REQUIRE_EQUAL(out_secrets.size(), 4u);
+    BOOST_REQUIRE(out_secrets[0].valid);
+    BOOST_REQUIRE(out_secrets[1].valid);
+    BOOST_REQUIRE(out_secrets[2].valid);
+    BOOST_REQUIRE(!out_secrets[3].valid);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// ----------------------------------------------------------------------------
+
 BOOST_AUTO_TEST_SUITE(encrypted__decrypt_public)
 
 // TODO: create compressed and altchain/testnet vector(s).
@@ -131,4 +131,38 @@ BOOST_AUTO_TEST_CASE(hd_private__derive_public__long_seed__expected)
     BOOST_REQUIRE_EQUAL(m0xH1yH2_pub.encoded(), "xpub6FnCn6nSzZAw5Tw7cgR9bi15UV96gLZhjDstkXXxvCLsUXBGXPdSnLFbdpq8p9HmGsApME5hQTZ3emM2rnY5agb9rXpVGyy3bdW6EEgAtqt");
 }
 
+BOOST_AUTO_TEST_CASE(hd_private__derive_range__short_seed__matches_derive_private)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    // The range spans the hardened boundary.
+    const hd_private m(seed, hd_private::mainnet);
+    const auto first = hd_first_hardened_key - 5;
+    const auto children = m.derive_range(first, 10, 4);
+    BOOST_REQUIRE_EQUAL(children.size(), 10u);
+
+    for (uint32_t position = 0; position < children.size(); ++position)
+        BOOST_REQUIRE(children[position] ==
+            m.derive_private(first + position));
+}
+
+BOOST_AUTO_TEST_CASE(hd_private__derive_range__zero_count__empty)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    BOOST_REQUIRE(m.derive_range(0, 0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(hd_private__derive_range__invalid_parent__invalid)
+{
+    const hd_private invalid;
+    const auto children = invalid.derive_range(0, 2);
+    BOOST_REQUIRE_EQUAL(children.size(), 2u);
+    BOOST_REQUIRE(!children[0]);
+    BOOST_REQUIRE(!children[1]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -96,4 +96,39 @@ BOOST_AUTO_TEST_CASE(hd_public__derive_public__long_seed__expected)
     BOOST_REQUIRE_EQUAL(m0xH1yH2_pub.encoded(), "xpub6FnCn6nSzZAw5Tw7cgR9bi15UV96gLZhjDstkXXxvCLsUXBGXPdSnLFbdpq8p9HmGsApME5hQTZ3emM2rnY5agb9rXpVGyy3bdW6EEgAtqt");
 }
 
+BOOST_AUTO_TEST_CASE(hd_public__derive_range__short_seed__matches_derive_public)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_public m_pub = hd_private(seed, hd_private::mainnet);
+    const auto children = m_pub.derive_range(0, 20, 3);
+    BOOST_REQUIRE_EQUAL(children.size(), 20u);
+
+    for (uint32_t index = 0; index < children.size(); ++index)
+        BOOST_REQUIRE(children[index] == m_pub.derive_public(index));
+}
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_range__hardened__invalid)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_public m_pub = hd_private(seed, hd_private::mainnet);
+    const auto children = m_pub.derive_range(hd_first_hardened_key - 1, 3);
+    BOOST_REQUIRE_EQUAL(children.size(), 3u);
+    BOOST_REQUIRE(children[0]);
+    BOOST_REQUIRE(!children[1]);
+    BOOST_REQUIRE(!children[2]);
+}
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_range__last_index__truncated)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_public m_pub = hd_private(seed, hd_private::mainnet);
+    BOOST_REQUIRE_EQUAL(m_pub.derive_range(max_uint32, 10).size(), 1u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
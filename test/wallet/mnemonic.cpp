@@ -38,6 +38,25 @@ BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonic__no_passphrase)
     }
 }
 
+BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonics__no_passphrase)
+{
+    mnemonic_list mnemonics;
+    for (const auto& vector: mnemonic_no_passphrase)
+        mnemonics.push_back(split(vector.mnemonic, ","));
+
+    const auto seeds = decode_mnemonics(mnemonics, 2);
+    BOOST_REQUIRE_EQUAL(seeds.size(), mnemonic_no_passphrase.size());
+
+    for (size_t index = 0; index < seeds.size(); ++index)
+        BOOST_REQUIRE_EQUAL(encode_base16(seeds[index]),
+            mnemonic_no_passphrase[index].seed);
+}
+
+BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonics__empty__empty)
+{
+    BOOST_REQUIRE(decode_mnemonics(mnemonic_list()).empty());
+}
+
 #ifdef WITH_ICU
 
 BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonic__trezor)
@@ -62,6 +81,26 @@ BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonic__bx)
     }
 }
 
+BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonics__trezor)
+{
+    mnemonic_list mnemonics;
+    for (const auto& vector: mnemonic_trezor_vectors)
+    {
+        // The trezor vectors share a single passphrase.
+        BOOST_REQUIRE_EQUAL(vector.passphrase,
+            mnemonic_trezor_vectors.front().passphrase);
+        mnemonics.push_back(split(vector.mnemonic, ","));
+    }
+
+    const auto passphrase = mnemonic_trezor_vectors.front().passphrase;
+    const auto seeds = decode_mnemonics(mnemonics, passphrase, 3);
+    BOOST_REQUIRE_EQUAL(seeds.size(), mnemonic_trezor_vectors.size());
+
+    for (size_t index = 0; index < seeds.size(); ++index)
+        BOOST_REQUIRE_EQUAL(encode_base16(seeds[index]),
+            mnemonic_trezor_vectors[index].seed);
+}
+
 #endif
 
 BOOST_AUTO_TEST_CASE(mnemonic__create_mnemonic__trezor)
@@ -147,4 +186,44 @@ BOOST_AUTO_TEST_CASE(mnemonic__dictionary__zh_Hans_Hant__intersection)
     BOOST_REQUIRE_EQUAL(intersection, 1275u);
 }
 
+BOOST_AUTO_TEST_CASE(mnemonic__validate_mnemonic__bad_checksum__false)
+{
+    // The last word carries the checksum of the preceding entropy.
+    auto words = create_mnemonic(data_chunk(16, 0x7f));
+    BOOST_REQUIRE(validate_mnemonic(words, language::en));
+    words.back() = words.back() == "abandon" ? "ability" : "abandon";
+    BOOST_REQUIRE(!validate_mnemonic(words, language::en));
+}
+
+BOOST_AUTO_TEST_CASE(mnemonic__dictionary_index__all_words__expected_positions)
+{
+    for (const auto lexicon: language::all)
+    {
+        const dictionary_index index(*lexicon);
+        for (size_t position = 0; position < dictionary_size; ++position)
+        {
+            const std::string word((*lexicon)[position]);
+            BOOST_REQUIRE_EQUAL(index.find(word), static_cast<int>(position));
+            BOOST_REQUIRE_EQUAL(find_word(*lexicon, word),
+                static_cast<int>(position));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mnemonic__dictionary_index__missing_word__negative)
+{
+    const dictionary_index index(language::en);
+    BOOST_REQUIRE_EQUAL(index.find(""), -1);
+    BOOST_REQUIRE_EQUAL(index.find("abandonment"), -1);
+    BOOST_REQUIRE_EQUAL(index.find(std::string("abandon\0", 8)), -1);
+    BOOST_REQUIRE_EQUAL(find_word(language::en, "zzz"), -1);
+}
+
+BOOST_AUTO_TEST_CASE(mnemonic__find_word__custom_dictionary__expected)
+{
+    const dictionary custom = language::es;
+    BOOST_REQUIRE_EQUAL(find_word(custom, custom[42]), 42);
+    BOOST_REQUIRE_EQUAL(find_word(custom, "abandon"), -1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
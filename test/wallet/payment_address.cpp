@@ -17,6 +17,8 @@
  * You should have received a copy of the GNU Affero General Public License
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
+#include <type_traits>
+#include <unordered_set>
 #include <boost/test/unit_test.hpp>
 #include <bitcoin/bitcoin.hpp>
 
@@ -283,4 +285,50 @@ BOOST_AUTO_TEST_CASE(payment_address__hash__compressed_point__expected)
     BOOST_REQUIRE_EQUAL(encode_base16(address.hash()), COMPRESSED_HASH);
 }
 
+BOOST_AUTO_TEST_CASE(payment_address__hash__uncompressed_point__expected)
+{
+    const payment_address address(ec_public(UNCOMPRESSED));
+    BOOST_REQUIRE(address);
+    BOOST_REQUIRE_EQUAL(encode_base16(address.hash()), UNCOMPRESSED_HASH);
+}
+
+// value type:
+
+BOOST_AUTO_TEST_CASE(payment_address__copy__trivially_copyable__true)
+{
+    BOOST_REQUIRE(std::is_trivially_copyable<payment_address>::value);
+    BOOST_REQUIRE(std::is_trivially_copyable<ec_public>::value);
+}
+
+BOOST_AUTO_TEST_CASE(payment_address__construct__string_overlong__invalid)
+{
+    // Trailing digits exceed the payment size before checksum validation.
+    const std::string overlong = std::string(ADDRESS_COMPRESSED) +
+        "zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz";
+    const payment_address address(overlong);
+    BOOST_REQUIRE(!address);
+}
+
+BOOST_AUTO_TEST_CASE(payment_address__hash__unordered_set__found)
+{
+    const payment_address compressed(ADDRESS_COMPRESSED);
+    const payment_address uncompressed(ADDRESS_UNCOMPRESSED);
+    std::unordered_set<payment_address> addresses{ compressed };
+    BOOST_REQUIRE_EQUAL(addresses.count(compressed), 1u);
+    BOOST_REQUIRE_EQUAL(addresses.count(uncompressed), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(payment_address__ec_public_hash__unordered_set__found)
+{
+    const ec_public compressed(COMPRESSED);
+    const ec_public uncompressed(UNCOMPRESSED);
+    BOOST_REQUIRE(compressed);
+    BOOST_REQUIRE(uncompressed);
+    BOOST_REQUIRE(!uncompressed.compressed());
+
+    std::unordered_set<ec_public> keys{ compressed };
+    BOOST_REQUIRE_EQUAL(keys.count(compressed), 1u);
+    BOOST_REQUIRE_EQUAL(keys.count(uncompressed), 0u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
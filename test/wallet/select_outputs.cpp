@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+using namespace bc::wallet;
+
+BOOST_AUTO_TEST_SUITE(select_outputs_tests)
+
+static output_info make_output(uint32_t index, uint64_t value)
+{
+    return output_info{ output_point{ null_hash, index }, value };
+}
+
+static output_info_list make_outputs(const std::vector<uint64_t>& values)
+{
+    output_info_list outputs;
+    for (size_t index = 0; index < values.size(); ++index)
+        outputs.push_back(make_output(static_cast<uint32_t>(index),
+            values[index]));
+
+    return outputs;
+}
+
+static uint64_t total(const output_info_list& outputs,
+    const output_point::list& points)
+{
+    uint64_t sum = 0;
+    for (const auto& point: points)
+        for (const auto& output: outputs)
+            if (output.point == point)
+                sum += output.value;
+
+    return sum;
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__greedy__empty__no_points)
+{
+    const auto result = select_outputs(output_info_list(), 42);
+    BOOST_REQUIRE(result.points.empty());
+    BOOST_REQUIRE_EQUAL(result.change, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__greedy__insufficient__no_points)
+{
+    const auto outputs = make_outputs({ 10, 20, 30 });
+    const auto result = select_outputs(outputs, 61);
+    BOOST_REQUIRE(result.points.empty());
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__greedy__sufficient_single__smallest_greater)
+{
+    const auto outputs = make_outputs({ 100, 5, 50, 60, 70 });
+    const auto result = select_outputs(outputs, 55);
+    BOOST_REQUIRE_EQUAL(result.points.size(), 1u);
+    BOOST_REQUIRE(result.points.front() == outputs[3].point);
+    BOOST_REQUIRE_EQUAL(result.change, 5u);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__greedy__lessers__largest_first)
+{
+    const auto outputs = make_outputs({ 10, 40, 30, 20 });
+    const auto result = select_outputs(outputs, 65);
+    BOOST_REQUIRE_EQUAL(result.points.size(), 2u);
+    BOOST_REQUIRE(result.points[0] == outputs[1].point);
+    BOOST_REQUIRE(result.points[1] == outputs[2].point);
+    BOOST_REQUIRE_EQUAL(result.change, 5u);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__greedy__duplicate_point__counted_once)
+{
+    auto outputs = make_outputs({ 30, 40 });
+    outputs.push_back(outputs[1]);
+    BOOST_REQUIRE(select_outputs(outputs, 75).points.empty());
+
+    const auto result = select_outputs(outputs, 70);
+    BOOST_REQUIRE_EQUAL(result.points.size(), 2u);
+    BOOST_REQUIRE(result.points[0] == outputs[1].point);
+    BOOST_REQUIRE(result.points[1] == outputs[0].point);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__largest_first__duplicate_point__counted_once)
+{
+    auto outputs = make_outputs({ 30, 40 });
+    outputs.push_back(outputs[1]);
+    const auto result = select_outputs(outputs, 75,
+        select_outputs_algorithm::largest_first);
+    BOOST_REQUIRE(result.points.empty());
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__largest_first__sufficient_single__largest)
+{
+    const auto outputs = make_outputs({ 100, 5, 50, 60 });
+    const auto result = select_outputs(outputs, 55,
+        select_outputs_algorithm::largest_first);
+    BOOST_REQUIRE_EQUAL(result.points.size(), 1u);
+    BOOST_REQUIRE(result.points.front() == outputs[0].point);
+    BOOST_REQUIRE_EQUAL(result.change, 45u);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__branch_and_bound__exact_subset__no_change)
+{
+    const auto outputs = make_outputs({ 1, 2, 5, 11, 40, 23 });
+    const auto result = select_outputs(outputs, 36,
+        select_outputs_algorithm::branch_and_bound);
+    BOOST_REQUIRE_EQUAL(result.change, 0u);
+    BOOST_REQUIRE_EQUAL(total(outputs, result.points), 36u);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__branch_and_bound__no_exact_subset__no_points)
+{
+    const auto outputs = make_outputs({ 10, 20, 40 });
+    const auto result = select_outputs(outputs, 35,
+        select_outputs_algorithm::branch_and_bound);
+    BOOST_REQUIRE(result.points.empty());
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__branch_and_bound__tolerance__least_change)
+{
+    const auto outputs = make_outputs({ 10, 20, 40 });
+    const auto result = select_outputs(outputs, 35,
+        select_outputs_algorithm::branch_and_bound, 5);
+    BOOST_REQUIRE_EQUAL(result.points.size(), 1u);
+    BOOST_REQUIRE(result.points.front() == outputs[2].point);
+    BOOST_REQUIRE_EQUAL(result.change, 5u);
+}
+
+BOOST_AUTO_TEST_CASE(output_index__branch_and_bound__tolerance__least_change)
+{
+    output_index index;
+    for (const auto& output: make_outputs({ 10, 20, 40 }))
+        BOOST_REQUIRE(index.insert(output));
+
+    const auto result = index.select(35,
+        select_outputs_algorithm::branch_and_bound, 5);
+    BOOST_REQUIRE_EQUAL(result.points.size(), 1u);
+    BOOST_REQUIRE_EQUAL(result.change, 5u);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__knapsack__exact_lessers__no_change)
+{
+    const auto outputs = make_outputs({ 3, 7, 20, 50, 1000 });
+    const auto result = select_outputs(outputs, 30,
+        select_outputs_algorithm::knapsack);
+    BOOST_REQUIRE_EQUAL(result.change, 0u);
+    BOOST_REQUIRE_EQUAL(total(outputs, result.points), 30u);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__knapsack__lessers_insufficient__smallest_greater)
+{
+    const auto outputs = make_outputs({ 3, 7, 200, 50 });
+    const auto result = select_outputs(outputs, 40,
+        select_outputs_algorithm::knapsack);
+    BOOST_REQUIRE_EQUAL(result.points.size(), 1u);
+    BOOST_REQUIRE(result.points.front() == outputs[3].point);
+    BOOST_REQUIRE_EQUAL(result.change, 10u);
+}
+
+BOOST_AUTO_TEST_CASE(output_index__insert__duplicate_point__false)
+{
+    output_index index;
+    BOOST_REQUIRE(index.insert(make_output(0, 10)));
+    BOOST_REQUIRE(!index.insert(make_output(0, 20)));
+    BOOST_REQUIRE_EQUAL(index.size(), 1u);
+    BOOST_REQUIRE_EQUAL(index.value(), 10u);
+}
+
+BOOST_AUTO_TEST_CASE(output_index__remove__selected_points__excluded)
+{
+    output_index index;
+    for (const auto& output: make_outputs({ 10, 10, 30 }))
+        index.insert(output);
+
+    const auto first = index.select(25);
+    BOOST_REQUIRE_EQUAL(first.points.size(), 1u);
+    index.remove(first.points);
+    BOOST_REQUIRE_EQUAL(index.size(), 2u);
+    BOOST_REQUIRE_EQUAL(index.value(), 20u);
+    BOOST_REQUIRE(!index.remove(first.points.front()));
+
+    const auto second = index.select(15);
+    BOOST_REQUIRE_EQUAL(second.points.size(), 2u);
+    BOOST_REQUIRE_EQUAL(second.change, 5u);
+    BOOST_REQUIRE(index.select(21).points.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
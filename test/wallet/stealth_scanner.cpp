@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+using namespace bc::wallet;
+
+#define SCAN_PRIVATE "fa63521e333e4b9f6a98a142680d3aef4d8e7f79723ce0043691db55c36bd905"
+#define SPEND_PRIVATE "dcc1250b51c0f03ae4e978e0256ede51dc1144e345c926262b9717b1bcc9bd1b"
+
+// The scan and spend keys of a stealth receiver.
+class stealth_keys_fixture
+{
+public:
+    stealth_keys_fixture()
+    {
+        BOOST_REQUIRE(decode_base16(scan_secret, SCAN_PRIVATE));
+        BOOST_REQUIRE(decode_base16(spend_secret, SPEND_PRIVATE));
+        BOOST_REQUIRE(secret_to_public(scan_public, scan_secret));
+        BOOST_REQUIRE(secret_to_public(spend_public, spend_secret));
+    }
+
+    ec_secret scan_secret;
+    ec_secret spend_secret;
+    ec_compressed scan_public;
+    ec_compressed spend_public;
+};
+
+BOOST_FIXTURE_TEST_SUITE(stealth_scanner_tests, stealth_keys_fixture)
+
+static output make_output(const operation::stack& ops)
+{
+    output out;
+    out.value = 0;
+    out.script = script{ ops };
+    return out;
+}
+
+// Pay a receiver by stealth, with a decoy output ahead of the payment.
+static transaction make_payment(ec_compressed& out_stealth,
+    const binary_type& filter, const ec_compressed& scan_public,
+    const ec_compressed& spend_public, const data_chunk& seed)
+{
+    ec_secret ephemeral_secret;
+    data_chunk stealth_data;
+    BOOST_REQUIRE(create_stealth_data(stealth_data, ephemeral_secret, filter,
+        seed));
+    BOOST_REQUIRE(uncover_stealth(out_stealth, scan_public, ephemeral_secret,
+        spend_public));
+
+    transaction tx;
+    tx.version = 1;
+    tx.locktime = 0;
+    tx.outputs.push_back(make_output(
+        operation::to_pay_key_hash_pattern(null_short_hash)));
+    tx.outputs.push_back(make_output(
+        operation::to_null_data_pattern(stealth_data)));
+    tx.outputs.push_back(make_output(
+        operation::to_pay_key_hash_pattern(bitcoin_short_hash(out_stealth))));
+    return tx;
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__scan__empty_block__no_matches)
+{
+    const stealth_scanner scanner(stealth_scan_key::list{});
+    BOOST_REQUIRE(scanner.scan(block()).empty());
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__scan__payment__matches_receiver_only)
+{
+    const binary_type filter("1011");
+    const data_chunk seed{ 0x2a, 0x2b, 0x2c };
+
+    ec_compressed stealth_public;
+    block payments;
+    payments.transactions.push_back(transaction());
+    payments.transactions.push_back(make_payment(stealth_public, filter,
+        scan_public, spend_public, seed));
+
+    // The decoy shares the filter but not the scan secret.
+    const stealth_scan_key::list keys
+    {
+        { spend_secret, spend_public, filter },
+        { scan_secret, spend_public, filter },
+        { scan_secret, spend_public, binary_type("0100") }
+    };
+
+    const stealth_scanner scanner(keys);
+    const auto matches = scanner.scan(payments, 2);
+    BOOST_REQUIRE_EQUAL(matches.size(), 1u);
+    BOOST_REQUIRE_EQUAL(matches[0].key, 1u);
+    BOOST_REQUIRE(matches[0].transaction == payments.transactions[1].hash());
+    BOOST_REQUIRE_EQUAL(matches[0].index, 2u);
+    BOOST_REQUIRE(matches[0].stealth_key == stealth_public);
+
+    // The receiver recovers the private key of the payment.
+    ec_secret stealth_secret;
+    ec_compressed recovered;
+    BOOST_REQUIRE(uncover_stealth(stealth_secret, matches[0].ephemeral_key,
+        scan_secret, spend_secret));
+    BOOST_REQUIRE(secret_to_public(recovered, stealth_secret));
+    BOOST_REQUIRE(recovered == stealth_public);
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__to_scan_key__single_spend_key__true)
+{
+    const binary_type filter("1011");
+    const stealth_address address(filter, scan_public, { spend_public });
+
+    stealth_scan_key key;
+    BOOST_REQUIRE(stealth_scanner::to_scan_key(key, address, scan_secret));
+    BOOST_REQUIRE(key.spend_key == spend_public);
+    BOOST_REQUIRE(key.filter == filter);
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__to_scan_key__multisig__false)
+{
+    const stealth_address address(binary_type("1011"), scan_public,
+        { spend_public, scan_public }, 1);
+
+    stealth_scan_key key;
+    BOOST_REQUIRE(!stealth_scanner::to_scan_key(key, address, scan_secret));
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__scan__bucketed_filters__matches_in_key_order)
+{
+    const binary_type filter("101100111000");
+    const data_chunk seed{ 0x2a, 0x2b, 0x2c };
+
+    ec_compressed stealth_public;
+    block payments;
+    payments.transactions.push_back(make_payment(stealth_public, filter,
+        scan_public, spend_public, seed));
+
+    // The short filter is unbucketed, the others bucketed by first byte.
+    const stealth_scan_key::list keys
+    {
+        { scan_secret, spend_public, binary_type("10") },
+        { scan_secret, spend_public, binary_type("001100111000") },
+        { scan_secret, spend_public, filter }
+    };
+
+    const stealth_scanner scanner(keys);
+    const auto matches = scanner.scan(payments, 1);
+    BOOST_REQUIRE_EQUAL(matches.size(), 2u);
+    BOOST_REQUIRE_EQUAL(matches[0].key, 0u);
+    BOOST_REQUIRE_EQUAL(matches[1].key, 2u);
+    BOOST_REQUIRE(matches[1].stealth_key == stealth_public);
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__scan__scheduler__matches_receiver)
+{
+    const binary_type filter("1011");
+    const data_chunk seed{ 0x2a, 0x2b, 0x2c };
+
+    ec_compressed stealth_public;
+    block payments;
+    payments.transactions.push_back(make_payment(stealth_public, filter,
+        scan_public, spend_public, seed));
+
+    const stealth_scan_key::list keys
+    {
+        { spend_secret, spend_public, filter },
+        { scan_secret, spend_public, filter }
+    };
+
+    scheduler executor(2);
+    const stealth_scanner scanner(keys);
+    const auto matches = scanner.scan(payments, executor);
+    BOOST_REQUIRE_EQUAL(matches.size(), 1u);
+    BOOST_REQUIRE_EQUAL(matches[0].key, 1u);
+    BOOST_REQUIRE(matches[0].stealth_key == stealth_public);
+}
+
+BOOST_AUTO_TEST_SUITE_END()